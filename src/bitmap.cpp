@@ -0,0 +1,246 @@
+#include "bitmap.h"
+#include <algorithm>
+
+using namespace std;
+
+namespace {
+    const size_t ARRAY_LIMIT = 4096;            //    ->  
+    const size_t BITSET_WORDS = 65536 / 64;
+
+    int popcount64(uint64_t x) {
+        //        
+        x = x - ((x >> 1) & 0x5555555555555555ULL);
+        x = (x & 0x3333333333333333ULL) + ((x >> 2) & 0x3333333333333333ULL);
+        x = (x + (x >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+        return static_cast<int>((x * 0x0101010101010101ULL) >> 56);
+    }
+}
+
+bool IdBitmap::Container::contains(uint16_t low) const {
+    if (isBitset()) {
+        return (bits[low >> 6] >> (low & 63)) & 1;
+    }
+    return binary_search(values.begin(), values.end(), low);
+}
+
+void IdBitmap::Container::add(uint16_t low) {
+    if (isBitset()) {
+        uint64_t mask = uint64_t(1) << (low & 63);
+        if (!(bits[low >> 6] & mask)) {
+            bits[low >> 6] |= mask;
+            count++;
+        }
+        return;
+    }
+
+    auto pos = lower_bound(values.begin(), values.end(), low);
+    if (pos != values.end() && *pos == low) {
+        return;
+    }
+    values.insert(pos, low);
+    count++;
+
+    if (count > ARRAY_LIMIT) {
+        toBitset();
+    }
+}
+
+void IdBitmap::Container::remove(uint16_t low) {
+    if (isBitset()) {
+        uint64_t mask = uint64_t(1) << (low & 63);
+        if (bits[low >> 6] & mask) {
+            bits[low >> 6] &= ~mask;
+            count--;
+        }
+        if (count <= ARRAY_LIMIT) {
+            toArray();
+        }
+        return;
+    }
+
+    auto pos = lower_bound(values.begin(), values.end(), low);
+    if (pos != values.end() && *pos == low) {
+        values.erase(pos);
+        count--;
+    }
+}
+
+void IdBitmap::Container::toBitset() {
+    if (isBitset()) {
+        return;
+    }
+    bits.assign(BITSET_WORDS, 0);
+    for (uint16_t low : values) {
+        bits[low >> 6] |= uint64_t(1) << (low & 63);
+    }
+    values.clear();
+    values.shrink_to_fit();
+}
+
+void IdBitmap::Container::toArray() {
+    if (!isBitset()) {
+        return;
+    }
+    values.clear();
+    values.reserve(count);
+    for (size_t w = 0; w < BITSET_WORDS; w++) {
+        uint64_t word = bits[w];
+        for (int bit = 0; word; bit++, word >>= 1) {
+            if (word & 1) {
+                values.push_back(static_cast<uint16_t>(w * 64 + bit));
+            }
+        }
+    }
+    bits.clear();
+    bits.shrink_to_fit();
+}
+
+IdBitmap::Container IdBitmap::intersect(const Container& a, const Container& b) {
+    Container result;
+
+    if (a.isBitset() && b.isBitset()) {
+        result.bits.resize(BITSET_WORDS);
+        for (size_t w = 0; w < BITSET_WORDS; w++) {
+            result.bits[w] = a.bits[w] & b.bits[w];
+            result.count += popcount64(result.bits[w]);
+        }
+        if (result.count <= ARRAY_LIMIT) {
+            result.toArray();
+        }
+        return result;
+    }
+
+    if (a.isBitset() || b.isBitset()) {
+        //     
+        const Container& array = a.isBitset() ? b : a;
+        const Container& bitset = a.isBitset() ? a : b;
+        for (uint16_t low : array.values) {
+            if (bitset.contains(low)) {
+                result.values.push_back(low);
+            }
+        }
+    } else {
+        set_intersection(a.values.begin(), a.values.end(),
+                         b.values.begin(), b.values.end(),
+                         back_inserter(result.values));
+    }
+    result.count = result.values.size();
+    return result;
+}
+
+void IdBitmap::uniteInto(Container& target, const Container& source) {
+    //   :         
+    if (!target.isBitset() && !source.isBitset() && target.count + source.count <= ARRAY_LIMIT) {
+        vector<uint16_t> merged;
+        merged.reserve(target.count + source.count);
+        set_union(target.values.begin(), target.values.end(),
+                  source.values.begin(), source.values.end(),
+                  back_inserter(merged));
+        target.values.swap(merged);
+        target.count = target.values.size();
+        return;
+    }
+
+    target.toBitset();
+    if (source.isBitset()) {
+        for (size_t w = 0; w < BITSET_WORDS; w++) {
+            uint64_t added = source.bits[w] & ~target.bits[w];
+            if (added) {
+                target.bits[w] |= added;
+                target.count += popcount64(added);
+            }
+        }
+    } else {
+        for (uint16_t low : source.values) {
+            uint64_t mask = uint64_t(1) << (low & 63);
+            if (!(target.bits[low >> 6] & mask)) {
+                target.bits[low >> 6] |= mask;
+                target.count++;
+            }
+        }
+    }
+}
+
+void IdBitmap::add(int id) {
+    chunks[id >> 16].add(static_cast<uint16_t>(id & 0xFFFF));
+}
+
+void IdBitmap::remove(int id) {
+    auto it = chunks.find(id >> 16);
+    if (it == chunks.end()) {
+        return;
+    }
+    it->second.remove(static_cast<uint16_t>(id & 0xFFFF));
+    if (it->second.count == 0) {
+        chunks.erase(it);
+    }
+}
+
+bool IdBitmap::contains(int id) const {
+    auto it = chunks.find(id >> 16);
+    return it != chunks.end() && it->second.contains(static_cast<uint16_t>(id & 0xFFFF));
+}
+
+size_t IdBitmap::size() const {
+    size_t total = 0;
+    for (const auto& chunk : chunks) {
+        total += chunk.second.count;
+    }
+    return total;
+}
+
+IdBitmap& IdBitmap::operator|=(const IdBitmap& other) {
+    for (const auto& chunk : other.chunks) {
+        auto it = chunks.find(chunk.first);
+        if (it == chunks.end()) {
+            chunks.insert(chunk);
+        } else {
+            uniteInto(it->second, chunk.second);
+        }
+    }
+    return *this;
+}
+
+IdBitmap& IdBitmap::operator&=(const IdBitmap& other) {
+    for (auto it = chunks.begin(); it != chunks.end(); ) {
+        auto other_it = other.chunks.find(it->first);
+        if (other_it == other.chunks.end()) {
+            it = chunks.erase(it);
+            continue;
+        }
+        it->second = intersect(it->second, other_it->second);
+        if (it->second.count == 0) {
+            it = chunks.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    return *this;
+}
+
+vector<int> IdBitmap::toVector() const {
+    vector<int> result;
+    result.reserve(size());
+
+    for (const auto& chunk : chunks) {
+        int high = chunk.first << 16;
+        const Container& container = chunk.second;
+
+        if (!container.isBitset()) {
+            for (uint16_t low : container.values) {
+                result.push_back(high | low);
+            }
+            continue;
+        }
+
+        for (size_t w = 0; w < BITSET_WORDS; w++) {
+            uint64_t word = container.bits[w];
+            for (int bit = 0; word; bit++, word >>= 1) {
+                if (word & 1) {
+                    result.push_back(high | static_cast<int>(w * 64 + bit));
+                }
+            }
+        }
+    }
+    return result;
+}
@@ -0,0 +1,48 @@
+#ifndef BITMAP_H
+#define BITMAP_H
+
+#include <vector>
+#include <map>
+#include <cstdint>
+#include <cstddef>
+
+//   ID   roaring bitmap: ID   
+//   16 ,     
+//  ( 4096 ),     65536 .
+class IdBitmap {
+private:
+    struct Container {
+        std::vector<uint16_t> values;  // ,   
+        std::vector<uint64_t> bits;    //  ,  
+        size_t count;
+
+        Container() : count(0) {}
+        bool isBitset() const { return !bits.empty(); }
+        bool contains(uint16_t low) const;
+        void add(uint16_t low);
+        void remove(uint16_t low);
+        void toBitset();
+        void toArray();
+    };
+
+    std::map<int, Container> chunks;
+
+    static Container intersect(const Container& a, const Container& b);
+    static void uniteInto(Container& target, const Container& source);
+
+public:
+    void add(int id);
+    void remove(int id);
+    bool contains(int id) const;
+
+    size_t size() const;
+    bool empty() const { return chunks.empty(); }
+    void clear() { chunks.clear(); }
+
+    IdBitmap& operator|=(const IdBitmap& other);
+    IdBitmap& operator&=(const IdBitmap& other);
+
+    std::vector<int> toVector() const;
+};
+
+#endif
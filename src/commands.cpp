@@ -0,0 +1,257 @@
+#include "commands.h"
+#include <sstream>
+#include <cstdio>
+#include <cctype>
+#include <vector>
+
+using namespace std;
+
+namespace {
+    string upper(string word) {
+        for (char& c : word) {
+            c = static_cast<char>(toupper(static_cast<unsigned char>(c)));
+        }
+        return word;
+    }
+
+    //      (   )
+    string rest(istringstream& in) {
+        string text;
+        getline(in >> ws, text);
+        return text;
+    }
+
+    bool parseField(const string& word, SortField& field) {
+        string name = upper(word);
+        if (name == "ID") field = SORT_BY_ID;
+        else if (name == "NAME") field = SORT_BY_NAME;
+        else if (name == "AGE") field = SORT_BY_AGE;
+        else if (name == "SALARY") field = SORT_BY_SALARY;
+        else return false;
+        return true;
+    }
+
+    void appendRow(string& out, const Record& record) {
+        char numbers[64];
+        out += to_string(record.id);
+        out += '\t';
+        out += record.name.c_str();
+        snprintf(numbers, sizeof(numbers), "\t%d\t%.2f\n", record.age, record.salary);
+        out += numbers;
+    }
+
+    string rows(const vector<Record>& records) {
+        string out = "ROWS " + to_string(records.size()) + "\n";
+        for (const auto& record : records) {
+            appendRow(out, record);
+        }
+        return out;
+    }
+
+    string find(Database& db, istringstream& in) {
+        string kind;
+        in >> kind;
+        kind = upper(kind);
+
+        if (kind == "NAME" || kind == "PREFIX" || kind == "PART") {
+            string name = rest(in);
+            if (name.empty()) {
+                return "ERR bad arguments\n";
+            }
+            if (kind == "NAME") return rows(db.searchByName(name));
+            if (kind == "PREFIX") return rows(db.searchByNamePrefix(name));
+            return rows(db.searchByNameSubstring(name));
+        }
+
+        if (kind == "AGE") {
+            int age;
+            return (in >> age) ? rows(db.searchByAge(age)) : "ERR bad arguments\n";
+        }
+
+        if (kind == "SALARY") {
+            double salary;
+            return (in >> salary) ? rows(db.searchBySalary(salary)) : "ERR bad arguments\n";
+        }
+
+        if (kind == "RANGE") {
+            int min_age, max_age;
+            double min_salary, max_salary;
+            if (!(in >> min_age >> max_age >> min_salary >> max_salary)) {
+                return "ERR bad arguments\n";
+            }
+            return rows(db.searchByAgeAndSalary(min_age, max_age, min_salary, max_salary));
+        }
+
+        return "ERR unknown search\n";
+    }
+}
+
+bool isWriteCommand(const string& line) {
+    istringstream in(line);
+    string command;
+    in >> command;
+    command = upper(command);
+    return command == "ADD" || command == "EDIT" || command == "DEL" ||
+           command == "LOAD" || command == "LOADBIN" || command == "IMPORT" ||
+           command == "BEGIN" || command == "COMMIT" || command == "ROLLBACK" ||
+           command == "JOURNAL" || command == "CHECKPOINT";
+}
+
+string executeCommand(Database& db, const string& line) {
+    //       "\r\n"
+    size_t length = line.size();
+    if (length > 0 && line[length - 1] == '\r') {
+        length--;
+    }
+    istringstream in(line.substr(0, length));
+    string command;
+    if (!(in >> command)) {
+        return "ERR empty command\n";
+    }
+    command = upper(command);
+
+    if (command == "PING") {
+        return "OK PONG\n";
+    }
+
+    if (command == "ADD") {
+        int age;
+        double salary;
+        if (!(in >> age >> salary)) {
+            return "ERR bad arguments\n";
+        }
+        if (!db.addRecord(rest(in), age, salary)) {
+            return "ERR invalid record\n";
+        }
+        return "OK " + to_string(db.getLastAddedId()) + "\n";
+    }
+
+    if (command == "EDIT") {
+        int id, age;
+        double salary;
+        if (!(in >> id >> age >> salary)) {
+            return "ERR bad arguments\n";
+        }
+        if (!db.findById(id)) {
+            return "ERR not found\n";
+        }
+        return db.editRecord(id, rest(in), age, salary) ? "OK\n" : "ERR invalid record\n";
+    }
+
+    if (command == "DEL") {
+        int id;
+        if (!(in >> id)) {
+            return "ERR bad arguments\n";
+        }
+        return db.deleteRecord(id) ? "OK\n" : "ERR not found\n";
+    }
+
+    if (command == "GET") {
+        int id;
+        if (!(in >> id)) {
+            return "ERR bad arguments\n";
+        }
+        const Record* record = db.findById(id);
+        return record ? rows(vector<Record>(1, *record)) : "ERR not found\n";
+    }
+
+    if (command == "FIND") {
+        return find(db, in);
+    }
+
+    if (command == "TOP") {
+        string field_name, order;
+        size_t k;
+        SortField field;
+        if (!(in >> field_name >> k) || !parseField(field_name, field)) {
+            return "ERR bad arguments\n";
+        }
+        in >> order;
+        return rows(db.topK(field, k, upper(order) == "ASC"));
+    }
+
+    if (command == "STATS") {
+        Summary summary = db.summarize();
+        char text[160];
+        snprintf(text, sizeof(text), "OK count=%lu avg_age=%.2f avg_salary=%.2f min_salary=%.2f max_salary=%.2f\n",
+                 static_cast<unsigned long>(summary.count), summary.averageAge(), summary.averageSalary(),
+                 summary.min_salary, summary.max_salary);
+        return text;
+    }
+
+    if (command == "SORT") {
+        string field_name, order;
+        SortField field;
+        if (!(in >> field_name) || !parseField(field_name, field)) {
+            return "ERR bad arguments\n";
+        }
+        in >> order;
+        bool ascending = upper(order) != "DESC";
+        switch (field) {
+            case SORT_BY_NAME:   db.sortByName(ascending); break;
+            case SORT_BY_AGE:    db.sortByAge(ascending); break;
+            case SORT_BY_SALARY: db.sortBySalary(ascending); break;
+            case SORT_BY_ID:
+            default:             db.sortById(ascending); break;
+        }
+        return "OK\n";
+    }
+
+    if (command == "LIST") {
+        size_t offset, limit;
+        if (!(in >> offset >> limit)) {
+            return "ERR bad arguments\n";
+        }
+        return rows(db.pageCurrentOrder(offset, limit));
+    }
+
+    if (command == "LOAD" || command == "SAVE" || command == "LOADBIN" || command == "SAVEBIN") {
+        string filename = rest(in);
+        if (filename.empty()) {
+            return "ERR bad arguments\n";
+        }
+        bool ok;
+        if (command == "LOAD") ok = db.loadFromFile(filename);
+        else if (command == "SAVE") ok = db.saveToFile(filename);
+        else if (command == "LOADBIN") ok = db.loadFromBinaryFile(filename);
+        else ok = db.saveToBinaryFile(filename);
+        return ok ? "OK " + to_string(db.getRecords().size()) + "\n" : "ERR file error\n";
+    }
+
+    if (command == "IMPORT" || command == "EXPORT") {
+        string format;
+        in >> format;
+        format = upper(format);
+        string filename = rest(in);
+        if ((format != "CSV" && format != "TSV") || filename.empty()) {
+            return "ERR bad arguments\n";
+        }
+        char delimiter = (format == "CSV") ? ',' : '\t';
+        bool ok = (command == "IMPORT") ? db.importCsv(filename, delimiter)
+                                        : db.exportCsv(filename, delimiter);
+        return ok ? "OK " + to_string(db.getRecords().size()) + "\n" : "ERR file error\n";
+    }
+
+    if (command == "BEGIN") {
+        return db.beginTransaction() ? "OK\n" : "ERR transaction already started\n";
+    }
+
+    if (command == "COMMIT") {
+        return db.commitTransaction() ? "OK\n" : "ERR commit failed\n";
+    }
+
+    if (command == "ROLLBACK") {
+        return db.rollbackTransaction() ? "OK\n" : "ERR no transaction\n";
+    }
+
+    if (command == "JOURNAL" || command == "CHECKPOINT") {
+        string filename = rest(in);
+        if (filename.empty()) {
+            return "ERR bad arguments\n";
+        }
+        bool ok = (command == "JOURNAL") ? db.attachJournal(filename) : db.checkpoint(filename);
+        return ok ? "OK\n" : "ERR file error\n";
+    }
+
+    return "ERR unknown command\n";
+}
@@ -0,0 +1,39 @@
+#ifndef COMMANDS_H
+#define COMMANDS_H
+
+#include <string>
+#include "database.h"
+
+//   :   -  .
+//  -   "OK ..."  "ERR ...",   
+//  "ROWS n"   n  "id<TAB><TAB><TAB>".
+//
+//   PING
+//   ADD <> <> <>
+//   EDIT <id> <> <> <>
+//   DEL <id>
+//   GET <id>
+//   FIND NAME|PREFIX|PART <>
+//   FIND AGE <> | FIND SALARY <>
+//   FIND RANGE <. > <. > <. > <. >
+//   TOP ID|NAME|AGE|SALARY <k> [ASC|DESC]
+//   STATS
+//   SORT ID|NAME|AGE|SALARY [ASC|DESC]
+//   LIST <> <>       (   )
+//   LOAD <> | SAVE <>          ( )
+//   LOADBIN <> | SAVEBIN <>    ( )
+//   IMPORT CSV|TSV <> | EXPORT CSV|TSV <>
+//   BEGIN | COMMIT | ROLLBACK          (    ;
+//                                       SAVE, SAVEBIN  EXPORT   )
+//   JOURNAL <>                     (    ;
+//                                            LOADBIN,
+//                                          )
+//   CHECKPOINT <>                  (    )
+//
+//     '\n'.
+std::string executeCommand(Database& db, const std::string& line);
+
+//      
+bool isWriteCommand(const std::string& line);
+
+#endif
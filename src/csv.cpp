@@ -0,0 +1,183 @@
+#include "csv.h"
+#include <algorithm>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define CSV_USE_SSE2
+#include <emmintrin.h>
+#endif
+
+using namespace std;
+
+const size_t CsvReader::CHUNK_SIZE;
+const size_t CsvReader::MAX_FIELD_SIZE;
+const size_t CsvWriter::BUFFER_SIZE;
+
+namespace {
+    bool isSpecial(char c, char delimiter) {
+        return c == delimiter || c == '"' || c == '\n' || c == '\r';
+    }
+
+    //   ,     (size,   ).
+    //  SSE2   16   .
+    size_t findSpecial(const char* data, size_t size, char delimiter) {
+        size_t i = 0;
+#ifdef CSV_USE_SSE2
+        const __m128i delimiters = _mm_set1_epi8(delimiter);
+        const __m128i quotes = _mm_set1_epi8('"');
+        const __m128i newlines = _mm_set1_epi8('\n');
+        const __m128i returns = _mm_set1_epi8('\r');
+        for (; i + 16 <= size; i += 16) {
+            __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+            __m128i hits = _mm_or_si128(
+                _mm_or_si128(_mm_cmpeq_epi8(chunk, delimiters), _mm_cmpeq_epi8(chunk, quotes)),
+                _mm_or_si128(_mm_cmpeq_epi8(chunk, newlines), _mm_cmpeq_epi8(chunk, returns)));
+            int mask = _mm_movemask_epi8(hits);
+            if (mask != 0) {
+                while ((mask & 1) == 0) {
+                    mask >>= 1;
+                    i++;
+                }
+                return i;
+            }
+        }
+#endif
+        for (; i < size; i++) {
+            if (isSpecial(data[i], delimiter)) {
+                return i;
+            }
+        }
+        return size;
+    }
+}
+
+CsvReader::CsvReader(FILE* file, char delimiter)
+    : file(file), delimiter(delimiter), buffer(CHUNK_SIZE), position(0), end(0),
+      line_number(0), truncated(false) {
+    //      ,  stdio  
+    setvbuf(file, nullptr, _IONBF, 0);
+}
+
+bool CsvReader::fill() {
+    position = 0;
+    end = fread(buffer.data(), 1, buffer.size(), file);
+    return end > 0;
+}
+
+void CsvReader::append(string& field, const char* data, size_t size) {
+    if (field.size() + size > MAX_FIELD_SIZE) {
+        size = MAX_FIELD_SIZE - field.size();
+        truncated = true;
+    }
+    field.append(data, size);
+}
+
+bool CsvReader::readRow(vector<string>& fields) {
+    fields.clear();
+    truncated = false;
+    if (position == end && !fill()) {
+        return false;
+    }
+    line_number++;
+    fields.push_back(string());
+    bool quoted = false;
+
+    //     -  ,  
+    while (position < end || fill()) {
+        if (quoted) {
+            const char* start = &buffer[position];
+            const char* quote = static_cast<const char*>(memchr(start, '"', end - position));
+            size_t size = quote ? static_cast<size_t>(quote - start) : end - position;
+            append(fields.back(), start, size);
+            line_number += count(start, start + size, '\n');
+            position += size;
+            if (!quote) {
+                continue;
+            }
+            position++;
+            //       
+            if ((position < end || fill()) && buffer[position] == '"') {
+                append(fields.back(), "\"", 1);
+                position++;
+            } else {
+                quoted = false;
+            }
+            continue;
+        }
+
+        size_t stop = position + findSpecial(&buffer[position], end - position, delimiter);
+        append(fields.back(), &buffer[position], stop - position);
+        position = stop;
+        if (position == end) {
+            continue;
+        }
+
+        char c = buffer[position++];
+        if (c == delimiter) {
+            fields.push_back(string());
+        } else if (c == '"') {
+            if (fields.back().empty()) {
+                quoted = true;
+            } else {
+                append(fields.back(), "\"", 1);
+            }
+        } else if (c == '\n') {
+            return true;
+        }
+        // '\r' (    Windows) 
+    }
+    return true;
+}
+
+CsvWriter::CsvWriter(FILE* file, char delimiter)
+    : file(file), delimiter(delimiter), buffer(BUFFER_SIZE), used(0),
+      row_started(false), failed(false) {
+    setvbuf(file, nullptr, _IONBF, 0);
+}
+
+void CsvWriter::reserve(size_t size) {
+    if (used + size > buffer.size()) {
+        flush();
+        if (size > buffer.size()) {
+            buffer.resize(size);
+        }
+    }
+}
+
+void CsvWriter::field(const char* text, size_t size) {
+    //  :   - ,    
+    reserve(2 * size + 3);
+    if (row_started) {
+        buffer[used++] = delimiter;
+    }
+    row_started = true;
+
+    if (findSpecial(text, size, delimiter) == size) {
+        memcpy(&buffer[used], text, size);
+        used += size;
+        return;
+    }
+
+    buffer[used++] = '"';
+    for (size_t i = 0; i < size; i++) {
+        if (text[i] == '"') {
+            buffer[used++] = '"';
+        }
+        buffer[used++] = text[i];
+    }
+    buffer[used++] = '"';
+}
+
+void CsvWriter::endRow() {
+    reserve(1);
+    buffer[used++] = '\n';
+    row_started = false;
+}
+
+bool CsvWriter::flush() {
+    if (used > 0 && fwrite(buffer.data(), 1, used, file) != used) {
+        failed = true;
+    }
+    used = 0;
+    return !failed;
+}
@@ -0,0 +1,67 @@
+#ifndef CSV_H
+#define CSV_H
+
+#include <string>
+#include <vector>
+#include <cstdio>
+#include <cstddef>
+
+//   CSV/TSV (RFC 4180):     
+// ,     .   
+//  ,      ,
+//       .
+class CsvReader {
+private:
+    FILE* file;
+    char delimiter;
+    std::vector<char> buffer;
+    size_t position;
+    size_t end;
+    size_t line_number;
+    bool truncated;
+
+    bool fill();
+    void append(std::string& field, const char* data, size_t size);
+
+public:
+    static const size_t CHUNK_SIZE = 1 << 20;
+    static const size_t MAX_FIELD_SIZE = 1 << 16;  //    
+
+    CsvReader(FILE* file, char delimiter);
+
+    //    ; false -  
+    bool readRow(std::vector<std::string>& fields);
+    //   ,      
+    size_t lineNumber() const { return line_number; }
+    //       MAX_FIELD_SIZE
+    bool rowTruncated() const { return truncated; }
+};
+
+//   CSV/TSV:     
+// ,       fwrite   stdio.
+class CsvWriter {
+private:
+    FILE* file;
+    char delimiter;
+    std::vector<char> buffer;
+    size_t used;
+    bool row_started;
+    bool failed;
+
+    void reserve(size_t size);
+
+public:
+    static const size_t BUFFER_SIZE = 1 << 20;
+
+    CsvWriter(FILE* file, char delimiter);
+
+    //    ,    ,    
+    void field(const char* text, size_t size);
+    void field(const std::string& text) { field(text.data(), text.size()); }
+    void endRow();
+
+    //    ; false -  
+    bool flush();
+};
+
+#endif
@@ -1,4 +1,5 @@
 #include "database.h"
+#include "csv.h"
 #include <iostream>
 #include <algorithm>
 #include <fstream>
@@ -6,6 +7,22 @@
 #include <vector>
 #include <cctype>
 #include <locale>
+#include <sstream>
+#include <cstring>
+#include <cstdint>
+#include <type_traits>
+#include <cstdio>
+#include <cstdlib>
+#include <cerrno>
+#include <climits>
+#include <iterator>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#include <fcntl.h>
+#endif
 
 #ifdef _WIN32
 #include <windows.h>
@@ -13,7 +30,63 @@
 
 using namespace std;
 
-Database::Database() : next_id(1) {
+const size_t FixedName::CAPACITY;
+const int Database::MAX_AGE;
+const int Database::SALARY_BUCKET;
+const int Database::MAX_MERGED_BUCKETS;
+const size_t Database::QUERY_CACHE_SIZE;
+const size_t Database::QUERY_CACHE_IDS;
+
+static_assert(is_trivially_copyable<Record>::value,
+              "Record      ");
+
+void FixedName::assign(const string& text) {
+    size_t count = min(text.size(), CAPACITY - 1);
+    memcpy(data, text.data(), count);
+    //   :      
+    memset(data + count, 0, CAPACITY - count);
+}
+
+bool FixedName::valid() const {
+    return memchr(data, '\0', CAPACITY) != nullptr;
+}
+
+size_t FixedName::length() const {
+    return strlen(data);
+}
+
+bool operator==(const FixedName& a, const string& b) {
+    return b.size() < FixedName::CAPACITY && a.length() == b.size() &&
+           memcmp(a.c_str(), b.data(), b.size()) == 0;
+}
+
+bool operator!=(const FixedName& a, const string& b) {
+    return !(a == b);
+}
+
+ostream& operator<<(ostream& out, const FixedName& name) {
+    return out << name.c_str();
+}
+
+//          (, ,  )
+bool hasControlChars(const char* text) {
+    for (; *text; text++) {
+        unsigned char c = static_cast<unsigned char>(*text);
+        if (c < 0x20 || c == 0x7f) {
+            return true;
+        }
+    }
+    return false;
+}
+
+Database::Database() : next_id(1), last_added_id(0), sort_field(SORT_BY_ID), sort_ascending(true), sorted(false),
+    age_index(MAX_AGE + 1), positions_valid(false),
+    query_cache(QUERY_CACHE_SIZE, QUERY_CACHE_IDS), table_version(0), verbose(true),
+    in_transaction(false), logging(true) {
+    for (unsigned long& version : column_versions) {
+        version = 0;
+    }
+    
     //    Windows
     #ifdef _WIN32
     SetConsoleOutputCP(1251);
@@ -21,35 +94,53 @@ Database::Database() : next_id(1) {
     #endif
 }
 
-bool Database::addRecord(const string& name, int age, double salary) {
+bool Database::validateFields(const string& name, int age, double salary) const {
     if (age <= 0) {
-        cout << ":    " << endl;
+        messages() << ":    " << endl;
         return false;
     }
     if (salary < 0) {
-        cout << ":     " << endl;
+        messages() << ":     " << endl;
         return false;
     }
     if (name.empty()) {
-        cout << ":     ." << endl;
+        messages() << ":     ." << endl;
         return false;
     }
     
     if (name.length() > 50) {
-        cout << ":    ( 50 )." << endl;
+        messages() << ":    ( 50 )." << endl;
         return false;
     }
     
-    if (age > 150) {  //  
-        cout << ":   ( 150 )." << endl;
+    if (hasControlChars(name.c_str())) {
+        messages() << ":    ." << endl;
+        return false;
+    }
+    
+    if (age > MAX_AGE) {  //  
+        messages() << ":   ( 150 )." << endl;
         return false;
     }
     
     if (salary > 1000000000) {  // 1  
-        cout << ":   ." << endl;
+        messages() << ":   ." << endl;
+        return false;
+    }
+    return true;
+}
+
+ostream& Database::messages() const {
+    //     
+    static ostream silent(nullptr);
+    return verbose ? cout : silent;
+}
+
+bool Database::addRecord(const string& name, int age, double salary) {
+    if (!validateFields(name, age, salary)) {
         return false;
     }
-    Record newRecord;
+    Record newRecord = Record();
     
     //    ID   
     vector<bool> id_used(1000, false); //   1000 
@@ -82,9 +173,13 @@ bool Database::addRecord(const string& name, int age, double salary) {
     newRecord.age = age;
     newRecord.salary = salary;
     
-    records.push_back(newRecord);
+    insertSorted(newRecord);
+    indexRecord(newRecord);
+    table_version++;
+    logChange(CHANGE_ADD, newRecord, newRecord);
     
-    cout << "  (ID: " << newRecord.id << ")" << endl;
+    last_added_id = newRecord.id;
+    messages() << "  (ID: " << newRecord.id << ")" << endl;
     return true;
 }
 
@@ -94,18 +189,15 @@ void Database::displayAll() const {
         return;
     }
     
-    //      ID ()
-    vector<Record> sorted_records = records;
-    sort(sorted_records.begin(), sorted_records.end(),
-        [](const Record& a, const Record& b) {
-            return a.id < b.id;  //   ID
-        });
-    
     cout << "  (  ID)" << endl;
     cout << " : " << records.size() << endl;
+    displayRows(pageById(0, records.size()));
+}
+
+void Database::displayRows(const vector<Record>& rows) {
     cout << "ID\t\t\t\t" << endl;
     
-    for (const auto& record : sorted_records) {
+    for (const auto& record : rows) {
         //    
         cout << record.id << "\t";
         
@@ -119,91 +211,344 @@ void Database::displayAll() const {
         cout << record.age << "\t";
         cout << fixed << setprecision(2) << record.salary << endl;
     }
-    
 }
 
 bool Database::editRecord(int id, const string& new_name, int new_age, double new_salary) {
-    if (new_age <= 0) {
-        cout << ":    " << endl;
-        return false;
-    }
-    if (new_salary < 0) {
-        cout << ":     " << endl;
+    if (!validateFields(new_name, new_age, new_salary)) {
         return false;
     }
     
-    for (auto& record : records) {
-        if (record.id == id) {
-            record.name = new_name;
-            record.age = new_age;
-            record.salary = new_salary;
-            cout << " " << id << " ." << endl;
+    for (auto it = records.begin(); it != records.end(); ++it) {
+        if (it->id == id) {
+            Record before = *it;
+            unindexRecord(*it);
+            if (it->name != new_name) column_versions[SORT_BY_NAME]++;
+            if (it->age != new_age) column_versions[SORT_BY_AGE]++;
+            if (it->salary != new_salary) column_versions[SORT_BY_SALARY]++;
+            it->name = new_name;
+            it->age = new_age;
+            it->salary = new_salary;
+            indexRecord(*it);
+            Record updated = *it;
+            
+            //    
+            if (sorted && sort_field != SORT_BY_ID) {
+                size_t index = it - records.begin();
+                records.erase(it);
+                updatePositions(index);
+                insertSorted(updated);
+            }
+            logChange(CHANGE_EDIT, before, updated);
+            messages() << " " << id << " ." << endl;
             return true;
         }
     }
-    cout << " " << id << "  ." << endl;
+    messages() << " " << id << "  ." << endl;
     return false;
 }
 
+bool Database::insertRecord(const Record& record) {
+    if (record.id <= 0) {
+        messages() << ":  ID (" << record.id << ")." << endl;
+        return false;
+    }
+    if (!validateFields(record.name, record.age, record.salary)) {
+        return false;
+    }
+    if (all_ids.contains(record.id)) {
+        messages() << ":   ID " << record.id << "  ." << endl;
+        return false;
+    }
+    
+    insertSorted(record);
+    indexRecord(record);
+    table_version++;
+    logChange(CHANGE_ADD, record, record);
+    return true;
+}
+
 bool Database::deleteRecord(int id) {
-    for (auto it = records.begin(); it != records.end(); ++it) {
-        if (it->id == id) {
-            records.erase(it);
-            cout << " " << id << " ." << endl;
-            return true;
+    const Record* found = all_ids.contains(id) ? findById(id) : nullptr;
+    if (!found) {
+        messages() << " " << id << "  ." << endl;
+        return false;
+    }
+    
+    size_t index = found - records.data();
+    Record before = records[index];
+    unindexRecord(before);
+    id_positions.erase(id);
+    if (sorted) {
+        //   :     
+        records.erase(records.begin() + index);
+        updatePositions(index);
+    } else {
+        //   :      
+        if (index + 1 < records.size()) {
+            records[index] = records.back();
+            id_positions[records[index].id] = index;
         }
+        records.pop_back();
     }
-    cout << " " << id << "  ." << endl;
-    return false;
+    table_version++;
+    logChange(CHANGE_DELETE, before, before);
+    messages() << " " << id << " ." << endl;
+    return true;
+}
+
+//        
+string numberKey(double value) {
+    ostringstream key;
+    key << setprecision(17) << value;
+    return key.str();
 }
 
 vector<Record> Database::searchByName(const string& name) const {
-    vector<Record> result;
-    for (const auto& record : records) {
-        if (record.name == name) {
-            result.push_back(record);
+    return cachedQuery("name=" + name, dataVersion(SORT_BY_NAME), [this, &name]() {
+        //      ,    
+        vector<Record> result = fetchByIds(name_index.exact(name));
+        result.erase(remove_if(result.begin(), result.end(),
+            [&name](const Record& record) {
+                return record.name != name;
+            }), result.end());
+        return result;
+    });
+}
+
+vector<Record> Database::searchByNamePrefix(const string& prefix) const {
+    return cachedQuery("prefix=" + foldRussianCase(prefix), dataVersion(SORT_BY_NAME), [this, &prefix]() {
+        return fetchByIds(name_index.prefix(prefix));
+    });
+}
+
+vector<Record> Database::searchByNameSubstring(const string& part) const {
+    return cachedQuery("part=" + foldRussianCase(part), dataVersion(SORT_BY_NAME), [this, &part]() {
+        return fetchByIds(name_index.substring(part));
+    });
+}
+
+vector<NameMatch> Database::searchByNameFuzzy(const string& name, size_t limit,
+                                              const FuzzyCursor& after) const {
+    vector<NameMatch> result;
+    for (const auto& match : name_index.fuzzy(name, limit, after)) {
+        const Record* record = findById(match.first);
+        if (record) {
+            NameMatch entry;
+            entry.record = *record;
+            entry.score = match.second;
+            result.push_back(entry);
         }
     }
     return result;
 }
 
 vector<Record> Database::searchByAge(int age) const {
-    vector<Record> result;
-    for (const auto& record : records) {
-        if (record.age == age) {
-            result.push_back(record);
+    return searchByAgeRange(age, age);
+}
+
+vector<Record> Database::searchBySalary(double salary) const {
+    return searchBySalaryRange(salary, salary);
+}
+
+void Database::indexRecord(const Record& record) {
+    all_ids.add(record.id);
+    name_index.add(record.id, record.name);
+    if (record.age >= 1 && record.age <= MAX_AGE) {
+        age_index[record.age].add(record.id);
+    }
+    salary_index[static_cast<int>(record.salary / SALARY_BUCKET)].add(record.id);
+}
+
+void Database::unindexRecord(const Record& record) {
+    all_ids.remove(record.id);
+    name_index.remove(record.id, record.name);
+    if (record.age >= 1 && record.age <= MAX_AGE) {
+        age_index[record.age].remove(record.id);
+    }
+    auto bucket = salary_index.find(static_cast<int>(record.salary / SALARY_BUCKET));
+    if (bucket != salary_index.end()) {
+        bucket->second.remove(record.id);
+        if (bucket->second.empty()) {
+            salary_index.erase(bucket);
+        }
+    }
+}
+
+IdBitmap Database::ageRangeIds(int min_age, int max_age) const {
+    IdBitmap ids;
+    for (int age = max(min_age, 1); age <= min(max_age, MAX_AGE); age++) {
+        ids |= age_index[age];
+    }
+    return ids;
+}
+
+bool Database::salaryBuckets(double min_salary, double max_salary, int& first, int& last) {
+    const double max_allowed = 1000000000;  //      
+    if (!(min_salary <= max_salary) || max_salary < 0 || min_salary > max_allowed) {
+        return false;
+    }
+    //        int
+    first = static_cast<int>(max(min_salary, 0.0) / SALARY_BUCKET);
+    last = static_cast<int>(min(max_salary, max_allowed) / SALARY_BUCKET);
+    return true;
+}
+
+IdBitmap Database::salaryRangeIds(double min_salary, double max_salary) const {
+    //    ,   -  searchBy*Range
+    IdBitmap ids;
+    int first_bucket, last_bucket;
+    if (!salaryBuckets(min_salary, max_salary, first_bucket, last_bucket)) {
+        return ids;
+    }
+    auto first = salary_index.lower_bound(first_bucket);
+    auto last = salary_index.upper_bound(last_bucket);
+    for (auto it = first; it != last; ++it) {
+        ids |= it->second;
+    }
+    return ids;
+}
+
+const Record* Database::findById(int id) const {
+    if (!positions_valid) {
+        id_positions.clear();
+        id_positions.reserve(records.size());
+        for (size_t i = 0; i < records.size(); i++) {
+            id_positions[records[i].id] = i;
+        }
+        positions_valid = true;
+    }
+    
+    auto it = id_positions.find(id);
+    if (it == id_positions.end()) {
+        return nullptr;
+    }
+    return &records[it->second];
+}
+
+unsigned long Database::dataVersion(SortField field) const {
+    // ID    ,       
+    return field == SORT_BY_ID ? table_version : table_version + column_versions[field];
+}
+
+vector<Record> Database::cachedQuery(const string& key, unsigned long version,
+                                     const function<vector<Record>()>& query) const {
+    vector<int> ids;
+    if (query_cache.get(key, version, ids)) {
+        vector<Record> result;
+        result.reserve(ids.size());
+        for (int id : ids) {
+            const Record* record = findById(id);
+            if (record) {
+                result.push_back(*record);
+            }
         }
+        return result;
     }
+    
+    vector<Record> result = query();
+    ids.reserve(result.size());
+    for (const auto& record : result) {
+        ids.push_back(record.id);
+    }
+    query_cache.put(key, version, ids);
     return result;
 }
 
-vector<Record> Database::searchBySalary(double salary) const {
+vector<Record> Database::fetchByIds(const IdBitmap& ids) const {
     vector<Record> result;
-    for (const auto& record : records) {
-        if (record.salary == salary) {
-            result.push_back(record);
+    result.reserve(ids.size());
+    for (int id : ids.toVector()) {
+        const Record* record = findById(id);
+        if (record) {
+            result.push_back(*record);
         }
     }
     return result;
 }
 
-//        
-bool compareRussianStrings(const string& a, const string& b, bool ascending) {
-    string a_lower = a;
-    string b_lower = b;
+vector<Record> Database::searchByAgeRange(int min_age, int max_age) const {
+    string key = "age=" + to_string(min_age) + ".." + to_string(max_age);
+    return cachedQuery(key, dataVersion(SORT_BY_AGE), [this, min_age, max_age]() {
+        return fetchByIds(ageRangeIds(min_age, max_age));
+    });
+}
+
+vector<Record> Database::searchBySalaryRange(double min_salary, double max_salary) const {
+    return searchByAgeAndSalary(1, MAX_AGE, min_salary, max_salary);
+}
+
+vector<Record> Database::searchByAgeAndSalary(int min_age, int max_age,
+                                              double min_salary, double max_salary) const {
+    string key = "age=" + to_string(min_age) + ".." + to_string(max_age) +
+                 ";salary=" + numberKey(min_salary) + ".." + numberKey(max_salary);
+    //         
+    unsigned long version = dataVersion(SORT_BY_AGE) + dataVersion(SORT_BY_SALARY);
     
-    //      Windows-1251
-    for (char& c : a_lower) {
-        if (c >= '' && c <= '') {
-            c = c - '' + '';
+    return cachedQuery(key, version, [=]() {
+        auto outside = [=](const Record& record) {
+            return record.age < min_age || record.age > max_age ||
+                   !(record.salary >= min_salary && record.salary <= max_salary);
+        };
+        
+        int first_bucket, last_bucket;
+        if (!salaryBuckets(min_salary, max_salary, first_bucket, last_bucket)) {
+            return vector<Record>();
         }
-    }
-    
-    for (char& c : b_lower) {
-        if (c >= '' && c <= '') {
-            c = c - '' + '';
+        
+        //   ID -   -,    - 
+        // ,       .  
+        // ,          
+        size_t limit = records.size() / 32;
+        size_t age_candidates = records.size();
+        if (min_age > 1 || max_age < MAX_AGE) {
+            age_candidates = 0;
+            for (int age = max(min_age, 1); age <= min(max_age, MAX_AGE); age++) {
+                age_candidates += age_index[age].size();
+            }
         }
-    }
+        size_t salary_candidates = records.size();
+        if (last_bucket - first_bucket < MAX_MERGED_BUCKETS) {
+            salary_candidates = 0;
+            auto last = salary_index.upper_bound(last_bucket);
+            for (auto it = salary_index.lower_bound(first_bucket); it != last; ++it) {
+                salary_candidates += it->second.size();
+            }
+        }
+        
+        vector<Record> result;
+        if (min(age_candidates, salary_candidates) <= limit) {
+            IdBitmap ids;
+            if (age_candidates <= salary_candidates) {
+                ids = ageRangeIds(min_age, max_age);
+                if (salary_candidates <= limit) {
+                    ids &= salaryRangeIds(min_salary, max_salary);
+                }
+            } else {
+                ids = salaryRangeIds(min_salary, max_salary);
+            }
+            result = fetchByIds(ids);
+            result.erase(remove_if(result.begin(), result.end(), outside), result.end());
+            return result;
+        }
+        
+        //      -    ;
+        // ,     ,   ID
+        for (const auto& record : records) {
+            if (!outside(record)) {
+                result.push_back(record);
+            }
+        }
+        sort(result.begin(), result.end(), [](const Record& a, const Record& b) {
+            return a.id < b.id;
+        });
+        return result;
+    });
+}
+
+//        
+bool compareRussianStrings(const string& a, const string& b, bool ascending) {
+    string a_lower = foldRussianCase(a);
+    string b_lower = foldRussianCase(b);
     
     if (ascending) {
         return a_lower < b_lower;
@@ -212,136 +557,325 @@ bool compareRussianStrings(const string& a, const string& b, bool ascending) {
     }
 }
 
+//     
+bool compareRecords(const Record& a, const Record& b, SortField field, bool ascending) {
+    switch (field) {
+        case SORT_BY_NAME:
+            return compareRussianStrings(a.name, b.name, ascending);
+        case SORT_BY_AGE:
+            return ascending ? a.age < b.age : a.age > b.age;
+        case SORT_BY_SALARY:
+            return ascending ? a.salary < b.salary : a.salary > b.salary;
+        case SORT_BY_ID:
+        default:
+            return ascending ? a.id < b.id : a.id > b.id;
+    }
+}
+
+void Database::applySort(SortField field, bool ascending) {
+    //    addRecord/editRecord/deleteRecord
+    if (sorted && sort_field == field && sort_ascending == ascending) {
+        return;
+    }
+    
+    auto less = [field, ascending](const Record& a, const Record& b) {
+        return compareRecords(a, b, field, ascending);
+    };
+    
+    if (sorted && sort_field == field) {
+        //       -  
+        reverse(records.begin(), records.end());
+    } else if (!is_sorted(records.begin(), records.end(), less)) {
+        sort(records.begin(), records.end(), less);
+    }
+    
+    sorted = true;
+    positions_valid = false;
+    sort_field = field;
+    sort_ascending = ascending;
+}
+
+void Database::insertSorted(const Record& record) {
+    if (!sorted) {
+        //       
+        records.push_back(record);
+        if (positions_valid) {
+            id_positions[record.id] = records.size() - 1;
+        }
+        return;
+    }
+    
+    //   ,     
+    SortField field = sort_field;
+    bool ascending = sort_ascending;
+    auto pos = upper_bound(records.begin(), records.end(), record,
+        [field, ascending](const Record& a, const Record& b) {
+            return compareRecords(a, b, field, ascending);
+        });
+    size_t index = pos - records.begin();
+    records.insert(pos, record);
+    updatePositions(index);
+}
+
+void Database::updatePositions(size_t first) {
+    //    first ;    ,    
+    if (!positions_valid) {
+        return;
+    }
+    for (size_t i = first; i < records.size(); i++) {
+        id_positions[records[i].id] = i;
+    }
+}
+
 void Database::sortByName(bool ascending) {
     if (records.empty()) {
-        cout << "  .  ." << endl;
+        messages() << "  .  ." << endl;
         return;
     }
     
-    sort(records.begin(), records.end(), 
-        [ascending](const Record& a, const Record& b) {
-            return compareRussianStrings(a.name, b.name, ascending);
-        });
+    applySort(SORT_BY_NAME, ascending);
     
-    cout << "    (" 
-         << (ascending ? "-" : "-") << ")." << endl;
+    messages() << "    (" 
+               << (ascending ? "-" : "-") << ")." << endl;
 }
 
 void Database::sortByAge(bool ascending) {
     if (records.empty()) {
-        cout << "  .  ." << endl;
+        messages() << "  .  ." << endl;
         return;
     }
     
-    sort(records.begin(), records.end(), 
-        [ascending](const Record& a, const Record& b) {
-            if (ascending) {
-                return a.age < b.age;
-            } else {
-                return a.age > b.age;
-            }
-        });
+    applySort(SORT_BY_AGE, ascending);
     
-    cout << "    (" 
-         << (ascending ? "" : "") << ")." << endl;
+    messages() << "    (" 
+               << (ascending ? "" : "") << ")." << endl;
 }
 
 void Database::sortBySalary(bool ascending) {
     if (records.empty()) {
-        cout << "  .  ." << endl;
+        messages() << "  .  ." << endl;
         return;
     }
     
-    sort(records.begin(), records.end(), 
-        [ascending](const Record& a, const Record& b) {
-            if (ascending) {
-                return a.salary < b.salary;
-            } else {
-                return a.salary > b.salary;
-            }
-        });
+    applySort(SORT_BY_SALARY, ascending);
     
-    cout << "    (" 
-         << (ascending ? "" : "") << ")." << endl;
+    messages() << "    (" 
+               << (ascending ? "" : "") << ")." << endl;
 }
 
 void Database::sortById(bool ascending) {
     if (records.empty()) {
-        cout << "  .  ." << endl;
+        messages() << "  .  ." << endl;
         return;
     }
     
-    sort(records.begin(), records.end(), 
-        [ascending](const Record& a, const Record& b) {
-            if (ascending) {
-                return a.id < b.id;
-            } else {
-                return a.id > b.id;
-            }
-        });
+    applySort(SORT_BY_ID, ascending);
+    
+    messages() << "   ID (" 
+               << (ascending ? "" : "") << ")." << endl;
+}
+
+vector<Record> Database::topK(SortField field, size_t k, bool ascending) const {
+    string key = "top=" + to_string(field) + ":" + to_string(k) + (ascending ? ":asc" : ":desc");
+    return cachedQuery(key, dataVersion(field), [this, field, k, ascending]() {
+        return computeTopK(field, k, ascending);
+    });
+}
+
+vector<Record> Database::computeTopK(SortField field, size_t k, bool ascending) const {
+    vector<Record> result;
+    if (k == 0 || records.empty()) {
+        return result;
+    }
+    
+    //   k  :     , O(n log k)
+    auto worse = [field, ascending](const Record* a, const Record* b) {
+        return compareRecords(*a, *b, field, ascending);
+    };
+    vector<const Record*> heap;
+    heap.reserve(min(k, records.size()));
+    
+    for (const auto& record : records) {
+        if (heap.size() < k) {
+            heap.push_back(&record);
+            push_heap(heap.begin(), heap.end(), worse);
+        } else if (compareRecords(record, *heap.front(), field, ascending)) {
+            pop_heap(heap.begin(), heap.end(), worse);
+            heap.back() = &record;
+            push_heap(heap.begin(), heap.end(), worse);
+        }
+    }
+    
+    sort_heap(heap.begin(), heap.end(), worse);
+    result.reserve(heap.size());
+    for (const Record* record : heap) {
+        result.push_back(*record);
+    }
+    return result;
+}
+
+vector<Record> Database::pageById(int after_id, size_t limit) const {
+    vector<Record> result;
+    if (limit == 0) {
+        return result;
+    }
+    
+    //    ID -     
+    if (sorted && sort_field == SORT_BY_ID) {
+        if (sort_ascending) {
+            auto first = upper_bound(records.begin(), records.end(), after_id,
+                [](int id, const Record& record) { return id < record.id; });
+            size_t count = min(limit, static_cast<size_t>(records.end() - first));
+            return vector<Record>(first, first + count);
+        }
+        //   ID,  after_id,   ;     
+        auto last = partition_point(records.begin(), records.end(),
+            [after_id](const Record& record) { return record.id > after_id; });
+        size_t count = min(limit, static_cast<size_t>(last - records.begin()));
+        return vector<Record>(reverse_iterator<vector<Record>::const_iterator>(last),
+                              reverse_iterator<vector<Record>::const_iterator>(last - count));
+    }
+    
+    //   : limit  ID,  after_id
+    auto less_id = [](const Record* a, const Record* b) {
+        return a->id < b->id;
+    };
+    vector<const Record*> heap;
+    
+    for (const auto& record : records) {
+        if (record.id <= after_id) {
+            continue;
+        }
+        if (heap.size() < limit) {
+            heap.push_back(&record);
+            push_heap(heap.begin(), heap.end(), less_id);
+        } else if (record.id < heap.front()->id) {
+            pop_heap(heap.begin(), heap.end(), less_id);
+            heap.back() = &record;
+            push_heap(heap.begin(), heap.end(), less_id);
+        }
+    }
+    
+    sort_heap(heap.begin(), heap.end(), less_id);
+    result.reserve(heap.size());
+    for (const Record* record : heap) {
+        result.push_back(*record);
+    }
+    return result;
+}
+
+vector<Record> Database::pageCurrentOrder(size_t offset, size_t limit) const {
+    if (offset >= records.size()) {
+        return vector<Record>();
+    }
+    // offset + limit     limit
+    size_t end = offset + min(limit, records.size() - offset);
+    return vector<Record>(records.begin() + offset, records.begin() + end);
+}
+
+void Database::resetTable() {
+    records.clear();
+    sorted = false;
+    positions_valid = false;
+    age_index.assign(MAX_AGE + 1, IdBitmap());
+    salary_index.clear();
+    name_index.clear();
+    all_ids.clear();
+    table_version++;
+}
+
+bool Database::canLoad() const {
+    if (in_transaction) {
+        messages() << ":     ." << endl;
+        return false;
+    }
+    //    ,    ,
+    //       
+    if (!journal_path.empty()) {
+        messages() << ":     ." << endl;
+        return false;
+    }
+    return true;
+}
+
+bool Database::validateLoaded(const Record& r, const IdBitmap& loaded_ids, size_t line_num) const {
+    //    
+    if (hasControlChars(r.name.c_str())) {
+        messages() << ":       " << line_num
+                   << ",  ." << endl;
+        return false;
+    }
+    
+    if (r.id <= 0) {
+        messages() << ":  ID (" << r.id 
+                   << ")   " << line_num << ",  ." << endl;
+        return false;
+    }
+    
+    if (r.age <= 0 || r.age > MAX_AGE) {
+        messages() << ":   (" << r.age 
+                   << ")   " << line_num << ",  ." << endl;
+        return false;
+    }
     
-    cout << "   ID (" 
-         << (ascending ? "" : "") << ")." << endl;
+    if (!(r.salary >= 0 && r.salary <= 1000000000)) {
+        messages() << ":   (" << r.salary 
+                   << ")   " << line_num << ",  ." << endl;
+        return false;
+    }
+    
+    //   ID (   )
+    if (loaded_ids.contains(r.id)) {
+        messages() << ":  ID (" << r.id 
+                   << ")   " << line_num << ",  ." << endl;
+        return false;
+    }
+    return true;
 }
 
 bool Database::loadFromFile(const string& filename) {
+    if (!canLoad()) {
+        return false;
+    }
+    
     ifstream file(filename);
     if (!file.is_open()) {
-        cout << ":    : " << filename << endl;
+        messages() << ":    : " << filename << endl;
         return false;
     }
     
-    records.clear();
+    resetTable();
     
-    Record r;
+    Record r = Record();
+    string name;
+    IdBitmap loaded_ids;
     int line_num = 0;
     int loaded_count = 0;
     
-    while (file >> r.id >> r.name >> r.age >> r.salary) {
+    while (file >> r.id >> name >> r.age >> r.salary) {
         line_num++;
         
-        //    
-        if (r.id <= 0) {
-            cout << ":  ID (" << r.id 
-                 << ")   " << line_num << ",  ." << endl;
-            continue;
-        }
-        
-        if (r.age <= 0 || r.age > 150) {
-            cout << ":   (" << r.age 
-                 << ")   " << line_num << ",  ." << endl;
+        if (name.length() >= FixedName::CAPACITY) {
+            messages() << ":      " << line_num
+                       << ",  ." << endl;
             continue;
         }
+        r.name = name;
         
-        if (r.salary < 0 || r.salary > 1000000000) {
-            cout << ":   (" << r.salary 
-                 << ")   " << line_num << ",  ." << endl;
-            continue;
-        }
-        
-        //   ID (   )
-        bool duplicate_id = false;
-        for (const auto& record : records) {
-            if (record.id == r.id) {
-                cout << ":  ID (" << r.id 
-                     << ")   " << line_num << ",  ." << endl;
-                duplicate_id = true;
-                break;
-            }
-        }
-        
-        if (duplicate_id) {
+        if (!validateLoaded(r, loaded_ids, line_num)) {
             continue;
         }
         
         records.push_back(r);
+        loaded_ids.add(r.id);
+        indexRecord(r);
         loaded_count++;
     }
     
     file.close();
     
     if (file.bad()) {
-        cout << "   : " << filename << endl;
+        messages() << "   : " << filename << endl;
         return false;
     }
     
@@ -354,20 +888,33 @@ bool Database::loadFromFile(const string& filename) {
     }
     next_id = max_id + 1;
     
-    cout << " " << loaded_count << "   " << filename << endl;
+    messages() << " " << loaded_count << "   " << filename << endl;
     
     if (line_num > loaded_count) {
-        cout << " " << (line_num - loaded_count) 
-             << "  ." << endl;
+        messages() << " " << (line_num - loaded_count) 
+                   << "  ." << endl;
     }
     
     return true;
 }
 
+bool Database::canSave() const {
+    //     ,     
+    if (in_transaction) {
+        messages() << ":     ." << endl;
+        return false;
+    }
+    return true;
+}
+
 bool Database::saveToFile(const string& filename) const {
+    if (!canSave()) {
+        return false;
+    }
+    
     ofstream file(filename);
     if (!file.is_open()) {
-        cout << ":    : " << filename << endl;
+        messages() << ":    : " << filename << endl;
         return false;
     }
     
@@ -378,19 +925,578 @@ bool Database::saveToFile(const string& filename) const {
     }
     
     file.close();
-    cout << " " << records.size() << "   " << filename << endl;
+    messages() << " " << records.size() << "   " << filename << endl;
     return true;
 }
 
-bool Database::recordExists(int id) const {
+namespace {
+    //   :      
+    struct BinaryHeader {
+        char magic[4];
+        uint32_t record_size;
+        uint64_t count;
+    };
+    
+    const char BINARY_MAGIC[4] = { 'M', 'S', 'D', 'B' };
+    
+    //     
+    bool syncFile(FILE* file) {
+        if (fflush(file) != 0) {
+            return false;
+        }
+        #ifdef _WIN32
+        return _commit(_fileno(file)) == 0;
+        #else
+        return fsync(fileno(file)) == 0;
+        #endif
+    }
+    
+    //   target  source      
+    bool replaceFile(const string& source, const string& target) {
+        #ifdef _WIN32
+        return MoveFileExA(source.c_str(), target.c_str(),
+                           MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+        #else
+        if (rename(source.c_str(), target.c_str()) != 0) {
+            return false;
+        }
+        size_t slash = target.rfind('/');
+        string directory = (slash == string::npos) ? "." : target.substr(0, slash + 1);
+        int fd = open(directory.c_str(), O_RDONLY);
+        if (fd < 0) {
+            return false;
+        }
+        bool ok = fsync(fd) == 0;
+        close(fd);
+        return ok;
+        #endif
+    }
+}
+
+bool Database::writeBinary(FILE* file) const {
+    BinaryHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, BINARY_MAGIC, sizeof(header.magic));
+    header.record_size = sizeof(Record);
+    header.count = records.size();
+    
+    return fwrite(&header, sizeof(header), 1, file) == 1 &&
+           fwrite(records.data(), sizeof(Record), records.size(), file) == records.size();
+}
+
+bool Database::saveToBinaryFile(const string& filename) const {
+    if (!canSave()) {
+        return false;
+    }
+    
+    FILE* file = fopen(filename.c_str(), "wb");
+    if (!file) {
+        messages() << ":    : " << filename << endl;
+        return false;
+    }
+    
+    bool ok = writeBinary(file);
+    ok = (fclose(file) == 0) && ok;
+    
+    if (!ok) {
+        messages() << "   : " << filename << endl;
+        return false;
+    }
+    messages() << " " << records.size() << "   " << filename << endl;
+    return true;
+}
+
+bool Database::loadFromBinaryFile(const string& filename) {
+    if (!canLoad()) {
+        return false;
+    }
+    
+    ifstream file(filename, ios::binary);
+    if (!file.is_open()) {
+        messages() << ":    : " << filename << endl;
+        return false;
+    }
+    
+    file.seekg(0, ios::end);
+    uint64_t file_size = static_cast<uint64_t>(file.tellg());
+    file.seekg(0, ios::beg);
+    
+    BinaryHeader header;
+    if (!file.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+        memcmp(header.magic, BINARY_MAGIC, sizeof(header.magic)) != 0 ||
+        header.record_size != sizeof(Record) ||
+        (file_size - sizeof(header)) % sizeof(Record) != 0 ||
+        header.count != (file_size - sizeof(header)) / sizeof(Record)) {
+        messages() << ":   : " << filename << endl;
+        return false;
+    }
+    
+    //        
+    vector<Record> loaded(header.count);
+    if (!file.read(reinterpret_cast<char*>(loaded.data()), header.count * sizeof(Record))) {
+        messages() << "   : " << filename << endl;
+        return false;
+    }
+    
+    //     ,  
+    IdBitmap loaded_ids;
+    size_t kept = 0;
+    for (size_t i = 0; i < loaded.size(); i++) {
+        const Record& r = loaded[i];
+        if (r.id <= 0 || loaded_ids.contains(r.id) || !r.name.valid() || r.name.empty() ||
+            hasControlChars(r.name.c_str()) ||
+            r.age <= 0 || r.age > MAX_AGE || !(r.salary >= 0 && r.salary <= 1000000000)) {
+            continue;
+        }
+        loaded_ids.add(r.id);
+        loaded[kept++] = r;
+    }
+    loaded.resize(kept);
+    
+    resetTable();
+    records.swap(loaded);
+    
+    int max_id = 0;
     for (const auto& record : records) {
-        if (record.id == id) {
-            return true;
+        indexRecord(record);
+        max_id = max(max_id, record.id);
+    }
+    next_id = max_id + 1;
+    
+    messages() << " " << records.size() << "   " << filename << endl;
+    if (header.count > records.size()) {
+        messages() << " " << (header.count - records.size())
+                   << "  ." << endl;
+    }
+    return true;
+}
+
+namespace {
+    //      (   )
+    bool parseInt(const string& text, int& value) {
+        char* end = nullptr;
+        errno = 0;
+        long parsed = strtol(text.c_str(), &end, 10);
+        if (text.empty() || *end != '\0' || errno == ERANGE || parsed < INT_MIN || parsed > INT_MAX) {
+            return false;
+        }
+        value = static_cast<int>(parsed);
+        return true;
+    }
+    
+    bool parseDouble(const string& text, double& value) {
+        char* end = nullptr;
+        value = strtod(text.c_str(), &end);
+        return !text.empty() && *end == '\0';
+    }
+}
+
+bool Database::importCsv(const string& filename, char delimiter) {
+    if (!canLoad()) {
+        return false;
+    }
+    
+    FILE* file = fopen(filename.c_str(), "rb");
+    if (!file) {
+        messages() << ":    : " << filename << endl;
+        return false;
+    }
+    
+    resetTable();
+    
+    CsvReader reader(file, delimiter);
+    vector<string> fields;
+    IdBitmap loaded_ids;
+    size_t row_count = 0;
+    size_t loaded_count = 0;
+    bool first_row = true;
+    
+    while (reader.readRow(fields)) {
+        //     ID - 
+        Record r = Record();
+        bool header = first_row && !parseInt(fields[0], r.id);
+        first_row = false;
+        if (header || (fields.size() == 1 && fields[0].empty())) {
+            continue;
+        }
+        row_count++;
+        
+        if (fields.size() != 4 || !parseInt(fields[0], r.id) ||
+            !parseInt(fields[2], r.age) || !parseDouble(fields[3], r.salary)) {
+            messages() << ":    " << reader.lineNumber()
+                       << ",  ." << endl;
+            continue;
         }
+        
+        if (reader.rowTruncated() || fields[1].length() >= FixedName::CAPACITY) {
+            messages() << ":      " << reader.lineNumber()
+                       << ",  ." << endl;
+            continue;
+        }
+        if (fields[1].empty()) {
+            messages() << ":     " << reader.lineNumber()
+                       << ",  ." << endl;
+            continue;
+        }
+        r.name = fields[1];
+        
+        if (!validateLoaded(r, loaded_ids, reader.lineNumber())) {
+            continue;
+        }
+        
+        records.push_back(r);
+        loaded_ids.add(r.id);
+        indexRecord(r);
+        loaded_count++;
+    }
+    
+    bool read_error = ferror(file) != 0;
+    fclose(file);
+    if (read_error) {
+        messages() << "   : " << filename << endl;
+        return false;
+    }
+    
+    int max_id = 0;
+    for (const auto& record : records) {
+        max_id = max(max_id, record.id);
+    }
+    next_id = max_id + 1;
+    
+    messages() << " " << loaded_count << "   " << filename << endl;
+    if (row_count > loaded_count) {
+        messages() << " " << (row_count - loaded_count)
+                   << "  ." << endl;
+    }
+    return true;
+}
+
+bool Database::exportCsv(const string& filename, char delimiter) const {
+    if (!canSave()) {
+        return false;
+    }
+    
+    FILE* file = fopen(filename.c_str(), "wb");
+    if (!file) {
+        messages() << ":    : " << filename << endl;
+        return false;
+    }
+    
+    CsvWriter writer(file, delimiter);
+    writer.field("id");
+    writer.field("name");
+    writer.field("age");
+    writer.field("salary");
+    writer.endRow();
+    
+    //     ,      
+    char number[32];
+    for (const auto& record : records) {
+        writer.field(number, snprintf(number, sizeof(number), "%d", record.id));
+        writer.field(record.name.c_str(), record.name.length());
+        writer.field(number, snprintf(number, sizeof(number), "%d", record.age));
+        writer.field(number, snprintf(number, sizeof(number), "%.2f", record.salary));
+        writer.endRow();
+    }
+    
+    bool ok = writer.flush();
+    ok = (fclose(file) == 0) && ok;
+    if (!ok) {
+        messages() << "   : " << filename << endl;
+        return false;
+    }
+    messages() << " " << records.size() << "   " << filename << endl;
+    return true;
+}
+
+void Database::logChange(ChangeKind kind, const Record& before, const Record& after) {
+    if (!logging) {
+        return;
+    }
+    
+    string redo;
+    if (kind == CHANGE_DELETE) {
+        redo = "DEL " + to_string(before.id);
+    } else {
+        redo = (kind == CHANGE_ADD ? "INSERT " : "EDIT ") + to_string(after.id) + " " +
+               to_string(after.age) + " " + numberKey(after.salary) + " " + after.name.str();
+    }
+    
+    if (in_transaction) {
+        Change change;
+        change.kind = kind;
+        change.before = before;
+        undo_log.push_back(change);
+        redo_log.push_back(redo);
+    } else if (!journal_path.empty() && !writeJournal(vector<string>(1, redo))) {
+        //      
+        messages() << ":    : " << journal_path << endl;
+    }
+}
+
+void Database::undoChanges() {
+    //    ,      
+    bool was_verbose = verbose;
+    verbose = false;
+    logging = false;
+    for (auto it = undo_log.rbegin(); it != undo_log.rend(); ++it) {
+        const Record& before = it->before;
+        switch (it->kind) {
+            case CHANGE_ADD:
+                deleteRecord(before.id);
+                break;
+            case CHANGE_EDIT:
+                editRecord(before.id, before.name, before.age, before.salary);
+                break;
+            case CHANGE_DELETE:
+                insertRecord(before);
+                break;
+        }
+    }
+    logging = true;
+    verbose = was_verbose;
+    undo_log.clear();
+    redo_log.clear();
+}
+
+bool Database::writeJournal(const vector<string>& lines) const {
+    string block = "BEGIN\n";
+    for (const auto& line : lines) {
+        block += line;
+        block += '\n';
+    }
+    block += "COMMIT\n";
+    
+    FILE* file = fopen(journal_path.c_str(), "ab");
+    if (!file) {
+        return false;
+    }
+    
+    //   -     fsync
+    bool ok = fwrite(block.data(), 1, block.size(), file) == block.size() && syncFile(file);
+    return fclose(file) == 0 && ok;
+}
+
+bool Database::applyJournalLine(const string& line) {
+    istringstream in(line);
+    string op, name;
+    Record r = Record();
+    in >> op >> r.id;
+    
+    if (op == "DEL") {
+        return deleteRecord(r.id);
+    }
+    
+    if (!(in >> r.age >> r.salary)) {
+        return false;
+    }
+    //     :     -  
+    if (in.get() != ' ') {
+        return false;
+    }
+    getline(in, name);
+    r.name = name;
+    
+    if (op == "INSERT") {
+        return insertRecord(r);
+    }
+    if (op == "EDIT") {
+        return editRecord(r.id, name, r.age, r.salary);
     }
     return false;
 }
 
+bool Database::beginTransaction() {
+    if (in_transaction) {
+        messages() << ":   ." << endl;
+        return false;
+    }
+    in_transaction = true;
+    messages() << " ." << endl;
+    return true;
+}
+
+bool Database::commitTransaction() {
+    if (!in_transaction) {
+        messages() << ":   ." << endl;
+        return false;
+    }
+    in_transaction = false;
+    
+    if (!journal_path.empty() && !redo_log.empty() && !writeJournal(redo_log)) {
+        //        
+        messages() << ":    ,  ." << endl;
+        undoChanges();
+        return false;
+    }
+    
+    messages() << "  (: " << undo_log.size() << ")." << endl;
+    undo_log.clear();
+    redo_log.clear();
+    return true;
+}
+
+bool Database::rollbackTransaction() {
+    if (!in_transaction) {
+        messages() << ":   ." << endl;
+        return false;
+    }
+    in_transaction = false;
+    size_t count = undo_log.size();
+    undoChanges();
+    messages() << "  (: " << count << ")." << endl;
+    return true;
+}
+
+bool Database::attachJournal(const string& filename) {
+    if (in_transaction) {
+        messages() << ":      ." << endl;
+        return false;
+    }
+    if (!journal_path.empty()) {
+        messages() << ":   : " << journal_path << endl;
+        return false;
+    }
+    
+    //     BEGIN ... COMMIT
+    int replayed = 0;
+    vector<string> failed;
+    ifstream file(filename);
+    if (file.is_open()) {
+        bool was_verbose = verbose;
+        verbose = false;
+        logging = false;
+        
+        vector<pair<int, string> > block;
+        bool in_block = false;
+        int line_num = 0;
+        string line;
+        while (getline(file, line)) {
+            line_num++;
+            if (line == "BEGIN") {
+                block.clear();
+                in_block = true;
+            } else if (line == "COMMIT" && in_block) {
+                for (const auto& change : block) {
+                    if (!applyJournalLine(change.second)) {
+                        failed.push_back(to_string(change.first) + ": " + change.second);
+                    }
+                }
+                in_block = false;
+                replayed++;
+            } else if (in_block) {
+                block.push_back(make_pair(line_num, line));
+            }
+        }
+        
+        logging = true;
+        verbose = was_verbose;
+    }
+    
+    //       -    
+    if (!failed.empty()) {
+        for (const auto& line : failed) {
+            messages() << ":      " << line << endl;
+        }
+        messages() << "  : " << filename << " (: " << failed.size()
+                   << ").  ,    ." << endl;
+        return false;
+    }
+    
+    FILE* journal = fopen(filename.c_str(), "ab");
+    if (!journal) {
+        messages() << ":    : " << filename << endl;
+        return false;
+    }
+    fclose(journal);
+    
+    journal_path = filename;
+    messages() << " : " << filename
+               << " ( : " << replayed << ")." << endl;
+    return true;
+}
+
+bool Database::checkpoint(const string& filename) {
+    if (in_transaction) {
+        messages() << ":      ." << endl;
+        return false;
+    }
+    
+    //           fsync,
+    //             ,
+    //   
+    string temp = filename + ".tmp";
+    FILE* file = fopen(temp.c_str(), "wb");
+    if (!file) {
+        messages() << ":    : " << temp << endl;
+        return false;
+    }
+    bool ok = writeBinary(file) && syncFile(file);
+    ok = (fclose(file) == 0) && ok;
+    if (!ok || !replaceFile(temp, filename)) {
+        remove(temp.c_str());
+        messages() << "   : " << filename << endl;
+        return false;
+    }
+    
+    //    ,    
+    if (!journal_path.empty()) {
+        FILE* journal = fopen(journal_path.c_str(), "wb");
+        if (!journal) {
+            messages() << ":    : " << journal_path << endl;
+            return false;
+        }
+        ok = syncFile(journal);
+        fclose(journal);
+        if (!ok) {
+            return false;
+        }
+    }
+    messages() << " " << records.size() << "   " << filename << endl;
+    return true;
+}
+
+Summary::Summary() : count(0), total_salary(0), min_salary(0), max_salary(0), total_age(0) {}
+
+void Summary::add(const Record& record) {
+    if (count == 0 || record.salary < min_salary) min_salary = record.salary;
+    if (count == 0 || record.salary > max_salary) max_salary = record.salary;
+    total_salary += record.salary;
+    total_age += record.age;
+    count++;
+}
+
+void Summary::merge(const Summary& other) {
+    if (other.count == 0) {
+        return;
+    }
+    if (count == 0 || other.min_salary < min_salary) min_salary = other.min_salary;
+    if (count == 0 || other.max_salary > max_salary) max_salary = other.max_salary;
+    total_salary += other.total_salary;
+    total_age += other.total_age;
+    count += other.count;
+}
+
+double Summary::averageSalary() const {
+    return count ? total_salary / count : 0;
+}
+
+double Summary::averageAge() const {
+    return count ? static_cast<double>(total_age) / count : 0;
+}
+
+Summary Database::summarize() const {
+    Summary summary;
+    for (const auto& record : records) {
+        summary.add(record);
+    }
+    return summary;
+}
+
+bool Database::recordExists(int id) const {
+    return all_ids.contains(id);
+}
+
 void Record::display() const {
     cout << "ID: " << setw(3) << left << id 
          << ": " << setw(15) << left << name 
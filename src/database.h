@@ -3,20 +3,154 @@
 
 #include <vector>
 #include <string>
+#include <cstddef>
+#include <cstdio>
+#include <ostream>
+#include <map>
+#include <unordered_map>
+#include "bitmap.h"
+#include "name_index.h"
+#include "query_cache.h"
+#include <functional>
 
+enum SortField { SORT_BY_ID, SORT_BY_NAME, SORT_BY_AGE, SORT_BY_SALARY };
+
+// ,    :  50    .
+//   Record       .
+class FixedName {
+public:
+    static const size_t CAPACITY = 51;
+    
+    FixedName() : data() {}
+    FixedName(const std::string& text) { assign(text); }
+    FixedName(const char* text) { assign(text); }
+    FixedName& operator=(const std::string& text) { assign(text); return *this; }
+    FixedName& operator=(const char* text) { assign(text); return *this; }
+    
+    void assign(const std::string& text);
+    bool valid() const;
+    
+    const char* c_str() const { return data; }
+    size_t length() const;
+    bool empty() const { return data[0] == '\0'; }
+    std::string str() const { return std::string(data); }
+    std::string substr(size_t pos, size_t count) const { return str().substr(pos, count); }
+    operator std::string() const { return str(); }
+    
+private:
+    char data[CAPACITY];
+};
+
+bool operator==(const FixedName& a, const std::string& b);
+bool operator!=(const FixedName& a, const std::string& b);
+std::ostream& operator<<(std::ostream& out, const FixedName& name);
+
+//   Record() -     ,
+//        
 struct Record {
     int id;
-    std::string name;
+    FixedName name;
     int age;
     double salary;
     
     void display() const;
 };
 
+struct Summary {
+    size_t count;
+    double total_salary;
+    double min_salary;
+    double max_salary;
+    long long total_age;
+    
+    Summary();
+    void add(const Record& record);
+    void merge(const Summary& other);
+    double averageSalary() const;
+    double averageAge() const;
+};
+
+struct NameMatch {
+    Record record;
+    double score;
+};
+
+bool compareRecords(const Record& a, const Record& b, SortField field, bool ascending);
+
 class Database {
 private:
     std::vector<Record> records;
     int next_id;
+    int last_added_id;
+    
+    //   ,   
+    SortField sort_field;
+    bool sort_ascending;
+    bool sorted;
+    
+    //  :  1..150    
+    static const int MAX_AGE = 150;
+    static const int SALARY_BUCKET = 10000;
+    static const int MAX_MERGED_BUCKETS = 64;  //  -    
+    IdBitmap all_ids;  //  ID :     
+    std::vector<IdBitmap> age_index;
+    std::map<int, IdBitmap> salary_index;
+    NameIndex name_index;
+    
+    //    records  ID,  
+    mutable std::unordered_map<int, size_t> id_positions;
+    mutable bool positions_valid;
+    
+    //    (ID   )   :
+    // table_version   //,
+    // column_versions[] -      editRecord
+    static const size_t QUERY_CACHE_SIZE = 64;
+    static const size_t QUERY_CACHE_IDS = 4000000;  //   16  ID   
+    mutable LruCache<std::vector<int> > query_cache;
+    unsigned long table_version;
+    unsigned long column_versions[4];
+    
+    bool verbose;  //     
+    
+    // :         
+    //  ,        
+    enum ChangeKind { CHANGE_ADD, CHANGE_EDIT, CHANGE_DELETE };
+    struct Change {
+        ChangeKind kind;
+        Record before;  //  CHANGE_ADD -  
+    };
+    bool in_transaction;
+    bool logging;
+    std::vector<Change> undo_log;
+    std::vector<std::string> redo_log;
+    std::string journal_path;
+    
+    void logChange(ChangeKind kind, const Record& before, const Record& after);
+    void undoChanges();
+    bool writeJournal(const std::vector<std::string>& lines) const;
+    bool applyJournalLine(const std::string& line);
+    bool writeBinary(FILE* file) const;
+    
+    std::ostream& messages() const;
+    void resetTable();
+    bool canLoad() const;
+    bool canSave() const;
+    bool validateFields(const std::string& name, int age, double salary) const;
+    bool validateLoaded(const Record& record, const IdBitmap& loaded_ids, size_t line_num) const;
+    
+    void applySort(SortField field, bool ascending);
+    void insertSorted(const Record& record);
+    void updatePositions(size_t first);
+    void indexRecord(const Record& record);
+    void unindexRecord(const Record& record);
+    IdBitmap ageRangeIds(int min_age, int max_age) const;
+    IdBitmap salaryRangeIds(double min_salary, double max_salary) const;
+    static bool salaryBuckets(double min_salary, double max_salary, int& first, int& last);
+    std::vector<Record> fetchByIds(const IdBitmap& ids) const;
+    std::vector<Record> computeTopK(SortField field, size_t k, bool ascending) const;
+    unsigned long dataVersion(SortField field) const;
+    std::vector<Record> cachedQuery(const std::string& key, unsigned long version,
+                                    const std::function<std::vector<Record>()>& query) const;
     
 public:
     Database();
@@ -25,21 +159,54 @@ public:
     void displayAll() const;
     bool editRecord(int id, const std::string& new_name, int new_age, double new_salary);
     bool deleteRecord(int id);
+    bool insertRecord(const Record& record);
     
     std::vector<Record> searchByName(const std::string& name) const;
+    std::vector<Record> searchByNamePrefix(const std::string& prefix) const;
+    std::vector<Record> searchByNameSubstring(const std::string& part) const;
+    std::vector<NameMatch> searchByNameFuzzy(const std::string& name, size_t limit = 20,
+                                             const FuzzyCursor& after = FuzzyCursor()) const;
     std::vector<Record> searchByAge(int age) const;
     std::vector<Record> searchBySalary(double salary) const;
+    std::vector<Record> searchByAgeRange(int min_age, int max_age) const;
+    std::vector<Record> searchBySalaryRange(double min_salary, double max_salary) const;
+    std::vector<Record> searchByAgeAndSalary(int min_age, int max_age,
+                                             double min_salary, double max_salary) const;
     
     void sortByName(bool ascending = true);
     void sortByAge(bool ascending = true);
     void sortBySalary(bool ascending = true);
     void sortById(bool ascending = true);
     
+    std::vector<Record> topK(SortField field, size_t k, bool ascending = false) const;
+    std::vector<Record> pageById(int after_id, size_t limit) const;
+    std::vector<Record> pageCurrentOrder(size_t offset, size_t limit) const;
+    
     bool loadFromFile(const std::string& filename);
     bool saveToFile(const std::string& filename) const;
+    bool loadFromBinaryFile(const std::string& filename);
+    bool saveToBinaryFile(const std::string& filename) const;
+    // CSV (delimiter ',')  TSV ('\t'):   id,name,age,salary,
+    //   ,       
+    bool importCsv(const std::string& filename, char delimiter = ',');
+    bool exportCsv(const std::string& filename, char delimiter = ',') const;
+    
+    Summary summarize() const;
+    
+    bool beginTransaction();
+    bool commitTransaction();
+    bool rollbackTransaction();
+    bool inTransaction() const { return in_transaction; }
+    bool attachJournal(const std::string& filename);
+    bool checkpoint(const std::string& filename);
     
     bool recordExists(int id) const;
+    const Record* findById(int id) const;
+    int getLastAddedId() const { return last_added_id; }
+    void setVerbose(bool enabled) { verbose = enabled; }
     void displayCurrentOrder() const;
+    const CacheStats& getCacheStats() const { return query_cache.getStats(); }
+    static void displayRows(const std::vector<Record>& rows);
     const std::vector<Record>& getRecords() const { return records; }
 };
 
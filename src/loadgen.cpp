@@ -0,0 +1,226 @@
+//      (program --server <>).
+//         <> 
+//  ,   .    
+//  ()   .
+//
+// : loadgen <> [=4] [  =10000] [ =16]
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <deque>
+#include <thread>
+#include <chrono>
+#include <random>
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <cerrno>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+using namespace std;
+typedef chrono::steady_clock Clock;
+
+namespace {
+    const int KNOWN_IDS = 1000;  // ,    
+
+    int connectTo(const string& path) {
+        int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (fd < 0) {
+            return -1;
+        }
+        sockaddr_un address;
+        memset(&address, 0, sizeof(address));
+        address.sun_family = AF_UNIX;
+        strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path) - 1);
+        if (connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0) {
+            close(fd);
+            return -1;
+        }
+        return fd;
+    }
+
+    bool sendAll(int fd, const string& data) {
+        size_t sent = 0;
+        while (sent < data.size()) {
+            ssize_t n = send(fd, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+            if (n < 0 && errno == EINTR) continue;
+            if (n <= 0) return false;
+            sent += static_cast<size_t>(n);
+        }
+        return true;
+    }
+
+    //   : "OK ..."/"ERR ..."  "ROWS n"  n 
+    class ResponseReader {
+    private:
+        int fd;
+        string buffer;
+        size_t position;
+        size_t rows_left;
+
+        bool nextLine(string& line) {
+            while (true) {
+                size_t end = buffer.find('\n', position);
+                if (end != string::npos) {
+                    line.assign(buffer, position, end - position);
+                    position = end + 1;
+                    return true;
+                }
+                buffer.erase(0, position);
+                position = 0;
+
+                char chunk[64 * 1024];
+                ssize_t n = recv(fd, chunk, sizeof(chunk), 0);
+                if (n < 0 && errno == EINTR) continue;
+                if (n <= 0) return false;
+                buffer.append(chunk, static_cast<size_t>(n));
+            }
+        }
+
+    public:
+        explicit ResponseReader(int fd) : fd(fd), position(0), rows_left(0) {}
+
+        //    ; false -  
+        bool readResponse() {
+            string line;
+            if (!nextLine(line)) {
+                return false;
+            }
+            if (line.compare(0, 5, "ROWS ") == 0) {
+                rows_left = strtoul(line.c_str() + 5, nullptr, 10);
+                while (rows_left > 0) {
+                    if (!nextLine(line)) {
+                        return false;
+                    }
+                    rows_left--;
+                }
+            }
+            return true;
+        }
+    };
+
+    string makeRequest(mt19937& random) {
+        int kind = random() % 100;
+        if (kind < 70) {
+            return "GET " + to_string(1 + random() % KNOWN_IDS) + "\n";
+        }
+        if (kind < 90) {
+            return "FIND AGE " + to_string(20 + random() % 40) + "\n";
+        }
+        return "ADD " + to_string(20 + random() % 40) + " " +
+               to_string(30000 + random() % 100000) + " Loadgen\n";
+    }
+
+    void runClient(const string& path, int requests, int depth, unsigned seed,
+                   vector<double>& latencies, bool& failed) {
+        int fd = connectTo(path);
+        if (fd < 0) {
+            failed = true;
+            return;
+        }
+
+        mt19937 random(seed);
+        ResponseReader reader(fd);
+        deque<Clock::time_point> in_flight;
+        int sent = 0;
+        latencies.reserve(requests);
+
+        while (static_cast<int>(latencies.size()) < requests) {
+            //        
+            string batch;
+            Clock::time_point now = Clock::now();
+            while (sent < requests && static_cast<int>(in_flight.size()) < depth) {
+                batch += makeRequest(random);
+                in_flight.push_back(now);
+                sent++;
+            }
+            if (!batch.empty() && !sendAll(fd, batch)) {
+                failed = true;
+                break;
+            }
+
+            if (!reader.readResponse()) {
+                failed = true;
+                break;
+            }
+            latencies.push_back(chrono::duration<double, micro>(Clock::now() - in_flight.front()).count());
+            in_flight.pop_front();
+        }
+        close(fd);
+    }
+
+    double percentile(const vector<double>& sorted, double p) {
+        if (sorted.empty()) {
+            return 0;
+        }
+        size_t index = static_cast<size_t>(p / 100.0 * (sorted.size() - 1));
+        return sorted[index];
+    }
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        cout << ": loadgen <> [] [  ] [ ]" << endl;
+        return 1;
+    }
+    string path = argv[1];
+    int clients = argc > 2 ? max(1, atoi(argv[2])) : 4;
+    int requests = argc > 3 ? max(1, atoi(argv[3])) : 10000;
+    int depth = argc > 4 ? max(1, atoi(argv[4])) : 16;
+
+    //  : ,     GET
+    int fd = connectTo(path);
+    if (fd < 0) {
+        cout << ":     " << path << ": " << strerror(errno) << endl;
+        return 1;
+    }
+    {
+        string batch;
+        for (int i = 0; i < KNOWN_IDS; i++) {
+            batch += "ADD " + to_string(20 + i % 40) + " " + to_string(30000 + i * 10) + " Loadgen\n";
+        }
+        ResponseReader reader(fd);
+        sendAll(fd, batch);
+        for (int i = 0; i < KNOWN_IDS; i++) {
+            reader.readResponse();
+        }
+        close(fd);
+    }
+
+    vector<vector<double> > latencies(clients);
+    vector<char> failed(clients, 0);
+    vector<thread> workers;
+
+    Clock::time_point start = Clock::now();
+    for (int i = 0; i < clients; i++) {
+        workers.push_back(thread([&, i]() {
+            bool client_failed = false;
+            runClient(path, requests, depth, 12345u + i, latencies[i], client_failed);
+            failed[i] = client_failed;
+        }));
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    double seconds = chrono::duration<double>(Clock::now() - start).count();
+
+    vector<double> all;
+    for (int i = 0; i < clients; i++) {
+        if (failed[i]) {
+            cout << ":  " << i << "   ." << endl;
+        }
+        all.insert(all.end(), latencies[i].begin(), latencies[i].end());
+    }
+    sort(all.begin(), all.end());
+
+    cout << ": " << clients << ",  : " << depth << endl;
+    cout << ": " << all.size() << "  " << seconds << " " << endl;
+    cout << " : " << static_cast<long>(all.size() / seconds) << " /" << endl;
+    cout << ", : p50=" << percentile(all, 50) << " p90=" << percentile(all, 90)
+         << " p99=" << percentile(all, 99) << " p99.9=" << percentile(all, 99.9)
+         << " max=" << (all.empty() ? 0 : all.back()) << endl;
+    return 0;
+}
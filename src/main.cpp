@@ -5,7 +5,10 @@
 #include <cstdlib>
 #include <vector>
 #include "database.h"
+#include "server.h"
+#include "script.h"
 #include <climits>
+#include <iomanip>
 
 #ifdef _WIN32
 #include <windows.h>
@@ -140,6 +143,68 @@ string getRussianName(const string& prompt) {
     }
 }
 
+const size_t PAGE_SIZE = 20;
+
+//    , false -   
+bool askNextPage(size_t shown, size_t total) {
+    cout << "\n " << shown << "  " << total
+         << ". Enter -  , 0 -  : ";
+    string input;
+    getline(cin, input);
+    return input != "0";
+}
+
+//      ID ( -   ID)
+void browseAll(const Database& db) {
+    size_t total = db.getRecords().size();
+    if (total == 0) {
+        cout << "  ." << endl;
+        return;
+    }
+    
+    cout << "  (  ID)" << endl;
+    cout << " : " << total << endl;
+    
+    int cursor = 0;
+    size_t shown = 0;
+    while (true) {
+        vector<Record> page = db.pageById(cursor, PAGE_SIZE);
+        if (page.empty()) {
+            break;
+        }
+        Database::displayRows(page);
+        shown += page.size();
+        cursor = page.back().id;
+        
+        if (shown >= total || !askNextPage(shown, total)) {
+            break;
+        }
+    }
+}
+
+//      
+void browseCurrentOrder(const Database& db) {
+    size_t total = db.getRecords().size();
+    if (total == 0) {
+        cout << "  ." << endl;
+        return;
+    }
+    
+    cout << "  :" << endl;
+    
+    size_t offset = 0;
+    while (offset < total) {
+        for (const auto& record : db.pageCurrentOrder(offset, PAGE_SIZE)) {
+            record.display();
+        }
+        offset += PAGE_SIZE;
+        
+        if (offset >= total || !askNextPage(offset, total)) {
+            break;
+        }
+    }
+}
+
 void showMainMenu() {
     clearScreen();
     cout << "   " << endl;
@@ -163,9 +228,17 @@ void showSearchMenu(Database& db) {
     do {
         clearScreen();
         cout << "\n " << endl;
+        const CacheStats& stats = db.getCacheStats();
+        cout << "( :  " << stats.hits
+             << ",  " << stats.misses << ")" << endl;
         cout << "1.   " << endl;
         cout << "2.   " << endl;
         cout << "3.   " << endl;
+        cout << "4. -N " << endl;
+        cout << "5.      " << endl;
+        cout << "6.    " << endl;
+        cout << "7.    " << endl;
+        cout << "8.    " << endl;
         cout << "0.    " << endl;
         
         choice = getValidInt(" : ");
@@ -222,6 +295,109 @@ void showSearchMenu(Database& db) {
                 break;
             }
             
+            case 4: {
+                int field = getValidInt(" (1 - ID, 2 - , 3 - , 4 - ): ", 1, 4);
+                int order = getValidInt(" (1 - , 2 - ): ", 1, 2);
+                int count = getValidInt(" : ", 1, 1000);
+                
+                const SortField fields[] = { SORT_BY_ID, SORT_BY_NAME, SORT_BY_AGE, SORT_BY_SALARY };
+                vector<Record> results = db.topK(fields[field - 1], count, order == 2);
+                
+                clearScreen();
+                if (results.empty()) {
+                    cout << "  ." << endl;
+                } else {
+                    cout << "-" << results.size() << " :" << endl;
+                    for (const auto& record : results) {
+                        record.display();
+                    }
+                }
+                break;
+            }
+            
+            case 5: {
+                int min_age = getValidInt(" : ", 1, 150);
+                int max_age = getValidInt(" : ", min_age, 150);
+                double min_salary = getValidDouble(" : ");
+                double max_salary = getValidDouble(" : ", min_salary);
+                
+                vector<Record> results = db.searchByAgeAndSalary(min_age, max_age, min_salary, max_salary);
+                
+                clearScreen();
+                if (results.empty()) {
+                    cout << "     ." << endl;
+                } else {
+                    cout << " " << results.size() << " ():" << endl;
+                    for (const auto& record : results) {
+                        record.display();
+                    }
+                }
+                break;
+            }
+            
+            case 6:
+            case 7: {
+                string part;
+                cout << (choice == 6 ? "  : " : "  : ");
+                getline(cin, part);
+                
+                vector<Record> results = (choice == 6) ? db.searchByNamePrefix(part)
+                                                       : db.searchByNameSubstring(part);
+                
+                clearScreen();
+                if (results.empty()) {
+                    cout << "   '" << part << "'  ." << endl;
+                } else {
+                    cout << " " << results.size() << " ():" << endl;
+                    for (const auto& record : results) {
+                        record.display();
+                    }
+                }
+                break;
+            }
+            
+            case 8: {
+                string name;
+                cout << "   : ";
+                getline(cin, name);
+                
+                clearScreen();
+                
+                //  :  -   ID   
+                FuzzyCursor cursor;
+                size_t shown = 0;
+                while (true) {
+                    vector<NameMatch> page = db.searchByNameFuzzy(name, PAGE_SIZE, cursor);
+                    if (page.empty()) {
+                        break;
+                    }
+                    if (shown == 0) {
+                        cout << "  :" << endl;
+                    }
+                    for (const auto& match : page) {
+                        cout << "[" << fixed << setprecision(2) << match.score << "] ";
+                        match.record.display();
+                    }
+                    shown += page.size();
+                    cursor = FuzzyCursor(page.back().score, page.back().record.id);
+                    
+                    if (page.size() < PAGE_SIZE) {
+                        break;
+                    }
+                    cout << "\n " << shown
+                         << ". Enter -  , 0 -  : ";
+                    string input;
+                    getline(cin, input);
+                    if (input == "0") {
+                        break;
+                    }
+                }
+                if (shown == 0) {
+                    cout << "   ." << endl;
+                }
+                break;
+            }
+            
             case 0:
                 cout << "   ..." << endl;
                 break;
@@ -230,7 +406,7 @@ void showSearchMenu(Database& db) {
                 cout << " !" << endl;
         }
         
-        if (choice != 0 && choice >= 1 && choice <= 3) {
+        if (choice != 0 && choice >= 1 && choice <= 8) {
             cout << "\n Enter  ...";
             cin.get();
         }
@@ -261,49 +437,49 @@ void showSortMenu(Database& db) {
             case 1:
                 db.sortByName(true);
                 cout << "\n    (-):" << endl;
-                db.displayCurrentOrder();
+                browseCurrentOrder(db);
                 break;
                 
             case 2:
                 db.sortByName(false);
                 cout << "\n    (-):" << endl;
-                db.displayCurrentOrder();
+                browseCurrentOrder(db);
                 break;
                 
             case 3:
                 db.sortByAge(true);
                 cout << "\n    ():" << endl;
-                db.displayCurrentOrder();
+                browseCurrentOrder(db);
                 break;
                 
             case 4:
                 db.sortByAge(false);
                 cout << "\n    ():" << endl;
-                db.displayCurrentOrder();
+                browseCurrentOrder(db);
                 break;
                 
             case 5:
                 db.sortBySalary(true);
                 cout << "\n    ():" << endl;
-                db.displayCurrentOrder();
+                browseCurrentOrder(db);
                 break;
                 
             case 6:
                 db.sortBySalary(false);
                 cout << "\n    ():" << endl;
-                db.displayCurrentOrder();
+                browseCurrentOrder(db);
                 break;
                 
             case 7:
                 db.sortById(true);
                 cout << "\n   ID ():" << endl;
-                db.displayCurrentOrder();
+                browseCurrentOrder(db);
                 break;
                 
             case 8:
                 db.sortById(false);
                 cout << "\n   ID ():" << endl;
-                db.displayCurrentOrder();
+                browseCurrentOrder(db);
                 break;
                 
             case 0:
@@ -331,12 +507,26 @@ void addTestData(Database& db) {
     cout << "   !" << endl;
 }
 
-int main() {
+int main(int argc, char* argv[]) {
     setupConsole();
     
     Database db;
     int choice;
     
+    // program --server <> [  ]
+    if (argc >= 3 && string(argv[1]) == "--server") {
+        if (argc >= 4 && !db.loadFromFile(argv[3])) {
+            return 1;
+        }
+        return runServer(db, argv[2]);
+    }
+    
+    // program --exec < > [--echo]
+    if (argc >= 3 && string(argv[1]) == "--exec") {
+        bool echo = argc >= 4 && string(argv[3]) == "--echo";
+        return runScript(db, argv[2], echo);
+    }
+    
     clearScreen();
     cout << "   " << endl;
     cout << "      !" << endl;
@@ -365,7 +555,7 @@ int main() {
             }
             
             case 2:
-                db.displayAll();
+                browseAll(db);
                 break;
                 
             case 3: {
@@ -375,7 +565,7 @@ int main() {
                 double new_salary;
                 
                 cout << " " << endl;
-                db.displayAll();
+                browseAll(db);
                 
                 if (db.getRecords().empty()) {
                     cout << "   ." << endl;
@@ -400,7 +590,7 @@ int main() {
                 int id;
                 
                 cout << " " << endl;
-                db.displayAll();
+                browseAll(db);
                 
                 if (db.getRecords().empty()) {
                     cout << "   ." << endl;
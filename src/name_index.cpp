@@ -0,0 +1,202 @@
+#include "name_index.h"
+#include <algorithm>
+
+using namespace std;
+
+string foldRussianCase(const string& text) {
+    string folded = text;
+
+    //      Windows-1251
+    for (char& c : folded) {
+        if (c >= '' && c <= '') {
+            c = c - '' + '';
+        }
+    }
+    return folded;
+}
+
+vector<string> NameIndex::makeTrigrams(const string& folded, bool padded) {
+    //       
+    string text = padded ? "  " + folded + " " : folded;
+
+    vector<string> result;
+    for (size_t i = 0; i + 3 <= text.size(); i++) {
+        result.push_back(text.substr(i, 3));
+    }
+    sort(result.begin(), result.end());
+    result.erase(unique(result.begin(), result.end()), result.end());
+    return result;
+}
+
+void NameIndex::add(int id, const string& name) {
+    string folded = foldRussianCase(name);
+
+    auto it = terms.find(folded);
+    if (it == terms.end()) {
+        Term term;
+        if (!free_numbers.empty()) {
+            term.number = free_numbers.back();
+            free_numbers.pop_back();
+            term_names[term.number] = folded;
+        } else {
+            term.number = static_cast<int>(term_names.size());
+            term_names.push_back(folded);
+        }
+
+        for (const auto& trigram : makeTrigrams(folded, true)) {
+            trigrams[trigram].add(term.number);
+        }
+        it = terms.insert(make_pair(folded, term)).first;
+    }
+
+    it->second.ids.add(id);
+}
+
+void NameIndex::remove(int id, const string& name) {
+    auto it = terms.find(foldRussianCase(name));
+    if (it == terms.end()) {
+        return;
+    }
+
+    it->second.ids.remove(id);
+    if (!it->second.ids.empty()) {
+        return;
+    }
+
+    //     -    
+    int number = it->second.number;
+    for (const auto& trigram : makeTrigrams(it->first, true)) {
+        auto entry = trigrams.find(trigram);
+        if (entry != trigrams.end()) {
+            entry->second.remove(number);
+            if (entry->second.empty()) {
+                trigrams.erase(entry);
+            }
+        }
+    }
+    term_names[number].clear();
+    free_numbers.push_back(number);
+    terms.erase(it);
+}
+
+void NameIndex::clear() {
+    terms.clear();
+    term_names.clear();
+    free_numbers.clear();
+    trigrams.clear();
+}
+
+IdBitmap NameIndex::exact(const string& name) const {
+    auto it = terms.find(foldRussianCase(name));
+    return it != terms.end() ? it->second.ids : IdBitmap();
+}
+
+IdBitmap NameIndex::prefix(const string& prefix) const {
+    string folded = foldRussianCase(prefix);
+
+    IdBitmap result;
+    for (auto it = terms.lower_bound(folded); it != terms.end(); ++it) {
+        if (it->first.compare(0, folded.size(), folded) != 0) {
+            break;
+        }
+        result |= it->second.ids;
+    }
+    return result;
+}
+
+IdBitmap NameIndex::substring(const string& part) const {
+    string folded = foldRussianCase(part);
+
+    IdBitmap result;
+    if (folded.empty()) {
+        return result;
+    }
+
+    if (folded.size() < 3) {
+        //    -    
+        for (const auto& term : terms) {
+            if (term.first.find(folded) != string::npos) {
+                result |= term.second.ids;
+            }
+        }
+        return result;
+    }
+
+    //  - ,    
+    IdBitmap candidates;
+    bool first = true;
+    for (const auto& trigram : makeTrigrams(folded, false)) {
+        auto entry = trigrams.find(trigram);
+        if (entry == trigrams.end()) {
+            return result;
+        }
+        if (first) {
+            candidates = entry->second;
+            first = false;
+        } else {
+            candidates &= entry->second;
+        }
+    }
+
+    for (int number : candidates.toVector()) {
+        const string& name = term_names[number];
+        if (name.find(folded) != string::npos) {
+            result |= terms.at(name).ids;
+        }
+    }
+    return result;
+}
+
+vector<pair<int, double> > NameIndex::fuzzy(const string& name, size_t limit,
+                                            const FuzzyCursor& after, double min_score) const {
+    vector<string> query = makeTrigrams(foldRussianCase(name), true);
+
+    //        
+    unordered_map<int, int> shared;
+    for (const auto& trigram : query) {
+        auto entry = trigrams.find(trigram);
+        if (entry == trigrams.end()) {
+            continue;
+        }
+        for (int number : entry->second.toVector()) {
+            shared[number]++;
+        }
+    }
+
+    //      
+    vector<pair<double, int> > ranked;
+    for (const auto& candidate : shared) {
+        size_t own = makeTrigrams(term_names[candidate.first], true).size();
+        double score = static_cast<double>(candidate.second) /
+                       (query.size() + own - candidate.second);
+        //        
+        if (score >= min_score && score <= after.score) {
+            ranked.push_back(make_pair(score, candidate.first));
+        }
+    }
+    sort(ranked.begin(), ranked.end(),
+        [](const pair<double, int>& a, const pair<double, int>& b) {
+            return a.first > b.first;
+        });
+
+    //         ID,
+    //  (, ID)    
+    vector<pair<int, double> > result;
+    size_t group = 0;
+    while (group < ranked.size() && result.size() < limit) {
+        double score = ranked[group].first;
+        IdBitmap ids;
+        for (; group < ranked.size() && ranked[group].first == score; group++) {
+            ids |= terms.at(term_names[ranked[group].second]).ids;
+        }
+        for (int id : ids.toVector()) {
+            if (result.size() >= limit) {
+                break;
+            }
+            if (score < after.score || id > after.id) {
+                result.push_back(make_pair(id, score));
+            }
+        }
+    }
+    return result;
+}
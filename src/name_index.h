@@ -0,0 +1,56 @@
+#ifndef NAME_INDEX_H
+#define NAME_INDEX_H
+
+#include <string>
+#include <vector>
+#include <map>
+#include <unordered_map>
+#include <utility>
+#include "bitmap.h"
+
+//      Windows-1251 (    )
+std::string foldRussianCase(const std::string& text);
+
+//     :   
+//    (score, id)    ,   ID
+struct FuzzyCursor {
+    double score;
+    int id;
+
+    FuzzyCursor() : score(2.0), id(0) {}  //  :    1
+    FuzzyCursor(double score, int id) : score(score), id(id) {}
+};
+
+//  :      
+//            .
+class NameIndex {
+private:
+    struct Term {
+        int number;
+        IdBitmap ids;
+    };
+
+    std::map<std::string, Term> terms;              //   -> ID 
+    std::vector<std::string> term_names;            //  ->  
+    std::vector<int> free_numbers;
+    std::unordered_map<std::string, IdBitmap> trigrams;  //  ->  
+
+    static std::vector<std::string> makeTrigrams(const std::string& folded, bool padded);
+
+public:
+    void add(int id, const std::string& name);
+    void remove(int id, const std::string& name);
+    void clear();
+
+    IdBitmap exact(const std::string& name) const;
+    IdBitmap prefix(const std::string& prefix) const;
+    IdBitmap substring(const std::string& part) const;
+
+    // ID ,     (0..1)   ID,
+    //    after
+    std::vector<std::pair<int, double> > fuzzy(const std::string& name, size_t limit,
+                                               const FuzzyCursor& after = FuzzyCursor(),
+                                               double min_score = 0.3) const;
+};
+
+#endif
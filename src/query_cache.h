@@ -0,0 +1,120 @@
+#ifndef QUERY_CACHE_H
+#define QUERY_CACHE_H
+
+#include <string>
+#include <list>
+#include <unordered_map>
+#include <utility>
+#include <iterator>
+#include <cstddef>
+
+struct CacheStats {
+    size_t hits;
+    size_t misses;
+    size_t stale;       // ,    
+    size_t evictions;
+
+    CacheStats() : hits(0), misses(0), stale(0), evictions(0) {}
+};
+
+//  LRU-  .   
+//    ,    ;  
+//      .   
+// ,     (Value -   size()).
+//    : lookup    .
+template <typename Value>
+class LruCache {
+private:
+    struct Entry {
+        std::string key;
+        unsigned long version;
+        Value value;
+    };
+
+    typedef typename std::list<Entry>::iterator EntryIterator;
+
+    size_t capacity;
+    size_t max_total_size;
+    size_t total_size;
+    std::list<Entry> entries;  //   -  
+    std::unordered_map<std::string, EntryIterator> lookup;
+    CacheStats stats;
+
+    void erase(EntryIterator entry) {
+        total_size -= entry->value.size();
+        lookup.erase(entry->key);
+        entries.erase(entry);
+    }
+
+public:
+    LruCache(size_t capacity, size_t max_total_size)
+        : capacity(capacity), max_total_size(max_total_size), total_size(0) {}
+
+    LruCache(const LruCache& other)
+        : capacity(other.capacity), max_total_size(other.max_total_size), total_size(0) {}
+
+    LruCache& operator=(const LruCache& other) {
+        if (this != &other) {
+            clear();
+            capacity = other.capacity;
+            max_total_size = other.max_total_size;
+            stats = CacheStats();
+        }
+        return *this;
+    }
+
+    bool get(const std::string& key, unsigned long version, Value& value) {
+        auto it = lookup.find(key);
+        if (it == lookup.end()) {
+            stats.misses++;
+            return false;
+        }
+
+        if (it->second->version != version) {
+            erase(it->second);
+            stats.stale++;
+            stats.misses++;
+            return false;
+        }
+
+        entries.splice(entries.begin(), entries, it->second);
+        value = it->second->value;
+        stats.hits++;
+        return true;
+    }
+
+    void put(const std::string& key, unsigned long version, const Value& value) {
+        auto it = lookup.find(key);
+        if (it != lookup.end()) {
+            erase(it->second);
+        }
+        if (capacity == 0 || value.size() > max_total_size) {
+            return;
+        }
+
+        while (!entries.empty() &&
+               (entries.size() >= capacity || total_size + value.size() > max_total_size)) {
+            erase(std::prev(entries.end()));
+            stats.evictions++;
+        }
+
+        Entry entry;
+        entry.key = key;
+        entry.version = version;
+        entry.value = value;
+        entries.push_front(entry);
+        lookup[key] = entries.begin();
+        total_size += value.size();
+    }
+
+    void clear() {
+        entries.clear();
+        lookup.clear();
+        total_size = 0;
+    }
+
+    size_t size() const { return entries.size(); }
+    const CacheStats& getStats() const { return stats; }
+};
+
+#endif
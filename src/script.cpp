@@ -0,0 +1,110 @@
+#include "script.h"
+#include "commands.h"
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <map>
+#include <chrono>
+#include <cctype>
+
+using namespace std;
+typedef chrono::steady_clock Clock;
+
+namespace {
+    const int MAX_REPORTED_ERRORS = 10;
+
+    struct OperationStats {
+        size_t count;
+        size_t errors;
+        double total_us;
+
+        OperationStats() : count(0), errors(0), total_us(0) {}
+    };
+
+    //    : ,  FIND -    
+    string operationName(const string& line) {
+        istringstream in(line);
+        string command, kind;
+        in >> command;
+        for (char& c : command) {
+            c = static_cast<char>(toupper(static_cast<unsigned char>(c)));
+        }
+        if (command == "FIND" && in >> kind) {
+            for (char& c : kind) {
+                c = static_cast<char>(toupper(static_cast<unsigned char>(c)));
+            }
+            command += " " + kind;
+        }
+        return command;
+    }
+}
+
+int runScript(Database& db, const string& filename, bool echo) {
+    ifstream file(filename);
+    if (!file.is_open()) {
+        cout << ":    : " << filename << endl;
+        return 1;
+    }
+
+    db.setVerbose(false);
+
+    map<string, OperationStats> stats;
+    size_t total = 0;
+    size_t errors = 0;
+    int line_num = 0;
+    string line;
+
+    Clock::time_point start = Clock::now();
+    while (getline(file, line)) {
+        line_num++;
+        size_t first = line.find_first_not_of(" \t\r");
+        if (first == string::npos || line[first] == '#') {
+            continue;
+        }
+
+        Clock::time_point begin = Clock::now();
+        string response = executeCommand(db, line);
+        double elapsed = chrono::duration<double, micro>(Clock::now() - begin).count();
+
+        OperationStats& op = stats[operationName(line)];
+        op.count++;
+        op.total_us += elapsed;
+        total++;
+
+        if (response.compare(0, 3, "ERR") == 0) {
+            op.errors++;
+            errors++;
+            if (!echo && errors <= MAX_REPORTED_ERRORS) {
+                cout << " " << line_num << ": " << line << " -> " << response;
+            }
+        }
+        if (echo) {
+            cout << response;
+        }
+    }
+    double seconds = chrono::duration<double>(Clock::now() - start).count();
+
+    if (db.inTransaction()) {
+        db.rollbackTransaction();
+        cout << ":      ,  ." << endl;
+    }
+
+    if (errors > MAX_REPORTED_ERRORS && !echo) {
+        cout << "...   " << (errors - MAX_REPORTED_ERRORS) << " ." << endl;
+    }
+
+    cout << " : " << total << ", : " << errors
+         << ", : " << fixed << setprecision(3) << seconds << " " << endl;
+    cout << left << setw(14) << "" << right << setw(10) << "-"
+         << setw(10) << "" << setw(14) << ", " << setw(14) << ", " << endl;
+    for (const auto& entry : stats) {
+        const OperationStats& op = entry.second;
+        cout << left << setw(14) << entry.first << right << setw(10) << op.count
+             << setw(10) << op.errors
+             << setw(14) << setprecision(3) << op.total_us / 1000
+             << setw(14) << setprecision(2) << op.total_us / op.count << endl;
+    }
+
+    return errors == 0 ? 0 : 2;
+}
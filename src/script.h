@@ -0,0 +1,15 @@
+#ifndef SCRIPT_H
+#define SCRIPT_H
+
+#include <string>
+#include "database.h"
+
+//  :    (  commands.h,  
+//  ;      '#' )    
+//  .    :  ,   
+//    .  echo     .
+//
+//    : 0,     .
+int runScript(Database& db, const std::string& filename, bool echo);
+
+#endif
@@ -0,0 +1,260 @@
+#include "server.h"
+#include "commands.h"
+#include <iostream>
+
+#ifdef __linux__
+#include <unordered_map>
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <cstdint>
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#endif
+
+using namespace std;
+
+#ifdef __linux__
+
+namespace {
+    const size_t MAX_EVENTS = 64;
+    const size_t READ_CHUNK = 64 * 1024;
+    const size_t MAX_PENDING_INPUT = 1024 * 1024;  //   '\n'  -  
+    //      ,      
+    const size_t MAX_PENDING_OUTPUT = 4 * 1024 * 1024;
+
+    struct Client {
+        string input;
+        string output;
+        bool read_closed;  //     
+        uint32_t events;   //    epoll
+
+        Client() : read_closed(false), events(EPOLLIN | EPOLLRDHUP) {}
+    };
+
+    //   ,    
+    bool flushOutput(int fd, Client& client) {
+        size_t sent = 0;
+        while (sent < client.output.size()) {
+            ssize_t n = send(fd, client.output.data() + sent, client.output.size() - sent, MSG_NOSIGNAL);
+            if (n < 0) {
+                if (errno == EINTR) continue;
+                if (errno == EAGAIN || errno == EWOULDBLOCK) break;
+                return false;
+            }
+            sent += static_cast<size_t>(n);
+        }
+        client.output.erase(0, sent);
+        return true;
+    }
+
+    //   ,      
+    // (epoll  ,   ); false -  
+    bool readInput(int fd, Client& client) {
+        char buffer[READ_CHUNK];
+        while (true) {
+            ssize_t n = recv(fd, buffer, sizeof(buffer), 0);
+            if (n > 0) {
+                client.input.append(buffer, static_cast<size_t>(n));
+                return true;
+            }
+            if (n == 0) {
+                client.read_closed = true;
+                return true;
+            }
+            if (errno == EINTR) continue;
+            return errno == EAGAIN || errno == EWOULDBLOCK;
+        }
+    }
+
+    //       ; false -   SHUTDOWN.
+    //   ,  BEGIN:   ,
+    //       .
+    bool processInput(Database& db, int fd, Client& client, int& transaction_owner) {
+        size_t start = 0;
+        size_t end;
+        bool running = true;
+
+        while (running && client.output.size() < MAX_PENDING_OUTPUT &&
+               (end = client.input.find('\n', start)) != string::npos) {
+            string line = client.input.substr(start, end - start);
+            start = end + 1;
+
+            if (line == "SHUTDOWN" || line == "SHUTDOWN\r") {
+                client.output += "OK\n";
+                running = false;
+            } else if (db.inTransaction() && transaction_owner != fd && isWriteCommand(line)) {
+                client.output += "ERR transaction in progress\n";
+            } else {
+                client.output += executeCommand(db, line);
+                if (!db.inTransaction()) {
+                    transaction_owner = -1;
+                } else if (transaction_owner < 0) {
+                    transaction_owner = fd;
+                }
+            }
+        }
+        client.input.erase(0, start);
+        return running;
+    }
+}
+
+int runServer(Database& db, const string& socket_path) {
+    db.setVerbose(false);
+    signal(SIGPIPE, SIG_IGN);
+
+    sockaddr_un address;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (socket_path.empty() || socket_path.size() >= sizeof(address.sun_path)) {
+        cout << ":    : " << socket_path << endl;
+        return 1;
+    }
+    strcpy(address.sun_path, socket_path.c_str());
+
+    int listener = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0);
+    if (listener < 0) {
+        cout << ":    : " << strerror(errno) << endl;
+        return 1;
+    }
+
+    unlink(socket_path.c_str());
+    if (bind(listener, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0 ||
+        listen(listener, SOMAXCONN) < 0) {
+        cout << ":     " << socket_path << ": " << strerror(errno) << endl;
+        close(listener);
+        return 1;
+    }
+
+    int epoll_fd = epoll_create1(0);
+    epoll_event event;
+    memset(&event, 0, sizeof(event));
+    event.events = EPOLLIN;
+    event.data.fd = listener;
+    epoll_ctl(epoll_fd, EPOLL_CTL_ADD, listener, &event);
+
+    cout << " : " << socket_path << " (: " << db.getRecords().size() << ")" << endl;
+
+    unordered_map<int, Client> clients;
+    int transaction_owner = -1;
+    epoll_event events[MAX_EVENTS];
+    bool running = true;
+
+    while (running) {
+        int ready = epoll_wait(epoll_fd, events, MAX_EVENTS, -1);
+        if (ready < 0) {
+            if (errno == EINTR) continue;
+            cout << " epoll: " << strerror(errno) << endl;
+            break;
+        }
+
+        for (int i = 0; i < ready; i++) {
+            int fd = events[i].data.fd;
+
+            if (fd == listener) {
+                int client_fd;
+                while ((client_fd = accept4(listener, nullptr, nullptr, SOCK_NONBLOCK)) >= 0) {
+                    epoll_event client_event;
+                    memset(&client_event, 0, sizeof(client_event));
+                    client_event.events = EPOLLIN | EPOLLRDHUP;
+                    client_event.data.fd = client_fd;
+                    epoll_ctl(epoll_fd, EPOLL_CTL_ADD, client_fd, &client_event);
+                    clients[client_fd] = Client();
+                }
+                continue;
+            }
+
+            auto it = clients.find(fd);
+            if (it == clients.end()) {
+                continue;
+            }
+            Client& client = it->second;
+            bool open = true;
+
+            //   ,     
+            //    
+            if ((events[i].events & (EPOLLIN | EPOLLRDHUP | EPOLLHUP)) && (client.events & EPOLLIN)) {
+                open = readInput(fd, client);
+            }
+            if (events[i].events & EPOLLERR) {
+                open = false;
+            }
+
+            //     ;    ,
+            //     ,   
+            bool more = open;
+            while (more) {
+                if (!processInput(db, fd, client, transaction_owner)) {
+                    running = false;
+                }
+                if (!flushOutput(fd, client)) {
+                    open = false;
+                }
+                more = open && running && client.output.empty() &&
+                       client.input.find('\n') != string::npos;
+            }
+
+            bool has_command = client.input.find('\n') != string::npos;
+            if (!has_command && client.input.size() >= MAX_PENDING_INPUT) {
+                open = false;
+            }
+            //   :     ,
+            //        
+            if (client.read_closed && client.output.empty() && !has_command) {
+                open = false;
+            }
+
+            if (!open) {
+                //     
+                if (transaction_owner == fd) {
+                    db.rollbackTransaction();
+                    transaction_owner = -1;
+                }
+                epoll_ctl(epoll_fd, EPOLL_CTL_DEL, fd, nullptr);
+                close(fd);
+                clients.erase(it);
+                continue;
+            }
+
+            //    ,     ;
+            //  ,     
+            uint32_t wanted = 0;
+            if (!client.read_closed && client.output.size() < MAX_PENDING_OUTPUT &&
+                client.input.size() < MAX_PENDING_INPUT) {
+                wanted |= EPOLLIN | EPOLLRDHUP;
+            }
+            if (!client.output.empty()) {
+                wanted |= EPOLLOUT;
+            }
+            if (wanted != client.events) {
+                epoll_event client_event;
+                memset(&client_event, 0, sizeof(client_event));
+                client_event.events = wanted;
+                client_event.data.fd = fd;
+                epoll_ctl(epoll_fd, EPOLL_CTL_MOD, fd, &client_event);
+                client.events = wanted;
+            }
+        }
+    }
+
+    for (const auto& client : clients) {
+        close(client.first);
+    }
+    close(epoll_fd);
+    close(listener);
+    unlink(socket_path.c_str());
+
+    cout << " ." << endl;
+    return 0;
+}
+
+#else
+
+int runServer(Database&, const string&) {
+    cout << ":      Linux." << endl;
+    return 1;
+}
+
+#endif
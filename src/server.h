@@ -0,0 +1,20 @@
+#ifndef SERVER_H
+#define SERVER_H
+
+#include <string>
+#include "database.h"
+
+//  :        
+// Unix domain socket     commands.h.  
+//   ,    ():  
+//      ,    .
+//     ,     .
+//  SHUTDOWN  .
+//
+//  (BEGIN)   :   ,   
+//  ,      .
+//
+//    .    Linux (epoll).
+int runServer(Database& db, const std::string& socket_path);
+
+#endif
@@ -0,0 +1,160 @@
+//  ShardedDatabase   Database   .
+//      ,   
+//    ,      , 
+//    .   1 -  .
+//
+// : shardbench [=1000000] [=0 (  )] [ =4] [=200]
+
+#include "sharded_database.h"
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <thread>
+#include <chrono>
+#include <random>
+#include <algorithm>
+#include <functional>
+#include <cstdlib>
+#include <cmath>
+
+using namespace std;
+typedef chrono::steady_clock Clock;
+
+namespace {
+    struct RangeQuery {
+        int min_age;
+        int max_age;
+        double min_salary;
+        double max_salary;
+    };
+
+    double secondsSince(Clock::time_point start) {
+        return chrono::duration<double>(Clock::now() - start).count();
+    }
+
+    vector<int> sortedIds(const vector<Record>& rows) {
+        vector<int> ids;
+        ids.reserve(rows.size());
+        for (const auto& row : rows) {
+            ids.push_back(row.id);
+        }
+        sort(ids.begin(), ids.end());
+        return ids;
+    }
+
+    //        ,   
+    vector<double> salaries(const vector<Record>& rows) {
+        vector<double> values;
+        for (const auto& row : rows) {
+            values.push_back(row.salary);
+        }
+        return values;
+    }
+
+    void report(const string& name, double single, double sharded, size_t count) {
+        cout << left << setw(22) << name << right << fixed << setprecision(2)
+             << setw(12) << single * 1000 / count << setw(12) << sharded * 1000 / count
+             << setw(10) << single / sharded << "x" << endl;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    int total = argc > 1 ? max(1, atoi(argv[1])) : 1000000;
+    size_t shard_count = argc > 2 ? static_cast<size_t>(max(0, atoi(argv[2]))) : 0;
+    int writers = argc > 3 ? max(1, atoi(argv[3])) : 4;
+    int queries = argc > 4 ? max(1, atoi(argv[4])) : 200;
+
+    ShardedDatabase sharded(shard_count);
+    cout << ": " << total << ", : " << sharded.shardCount()
+         << ",  : " << writers << ", : " << thread::hardware_concurrency() << endl;
+
+    //    :         
+    Clock::time_point start = Clock::now();
+    vector<thread> workers;
+    for (int w = 0; w < writers; w++) {
+        workers.push_back(thread([&sharded, total, writers, w]() {
+            mt19937 random(1000u + w);
+            for (int i = w; i < total; i += writers) {
+                sharded.addRecord("" + to_string(random() % 100000),
+                                  20 + random() % 46, 20000 + random() % 180000);
+            }
+        }));
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    double insert_time = secondsSince(start);
+    cout << ": " << fixed << setprecision(3) << insert_time << "  ("
+         << static_cast<long>(total / insert_time) << " /)" << endl;
+
+    Database single;
+    single.setVerbose(false);
+    start = Clock::now();
+    for (const auto& record : sharded.sorted(SORT_BY_ID)) {
+        single.insertRecord(record);
+    }
+    cout << "   : " << secondsSince(start) << " " << endl;
+
+    mt19937 random(42);
+    vector<RangeQuery> ranges;
+    for (int i = 0; i < queries; i++) {
+        RangeQuery query;
+        query.min_age = 20 + random() % 40;
+        query.max_age = query.min_age + random() % 10;
+        query.min_salary = 20000 + random() % 150000;
+        query.max_salary = query.min_salary + random() % 20000;
+        ranges.push_back(query);
+    }
+
+    bool same = true;
+    cout << endl << left << setw(22) << "" << right << setw(12) << "Database"
+         << setw(12) << "Sharded" << setw(11) << "" << endl;
+    cout << "(  , )" << endl;
+
+    //     ,     
+    vector<vector<int> > expected;
+    start = Clock::now();
+    for (const auto& q : ranges) {
+        expected.push_back(sortedIds(single.searchByAgeAndSalary(q.min_age, q.max_age, q.min_salary, q.max_salary)));
+    }
+    double single_time = secondsSince(start);
+    start = Clock::now();
+    for (size_t i = 0; i < ranges.size(); i++) {
+        const RangeQuery& q = ranges[i];
+        vector<int> ids = sortedIds(sharded.searchByAgeAndSalary(q.min_age, q.max_age, q.min_salary, q.max_salary));
+        same = same && ids == expected[i];
+    }
+    report(" +/", single_time, secondsSince(start), ranges.size());
+
+    vector<vector<double> > expected_top;
+    start = Clock::now();
+    for (int i = 0; i < queries; i++) {
+        expected_top.push_back(salaries(single.topK(SORT_BY_SALARY, 10 + i, i % 2 == 0)));
+    }
+    single_time = secondsSince(start);
+    start = Clock::now();
+    for (int i = 0; i < queries; i++) {
+        same = same && salaries(sharded.topK(SORT_BY_SALARY, 10 + i, i % 2 == 0)) == expected_top[i];
+    }
+    report("-K  ", single_time, secondsSince(start), queries);
+
+    int summaries = max(1, queries / 10);
+    Summary single_summary;
+    Summary sharded_summary;
+    start = Clock::now();
+    for (int i = 0; i < summaries; i++) {
+        single_summary = single.summarize();
+    }
+    single_time = secondsSince(start);
+    start = Clock::now();
+    for (int i = 0; i < summaries; i++) {
+        sharded_summary = sharded.summarize();
+    }
+    report("", single_time, secondsSince(start), summaries);
+    same = same && single_summary.count == sharded_summary.count &&
+           fabs(single_summary.total_salary - sharded_summary.total_salary) < 1e-6 * single_summary.total_salary;
+
+    cout << endl << " : " << (same ? "" : "") << endl;
+    return same ? 0 : 1;
+}
@@ -0,0 +1,248 @@
+#include "sharded_database.h"
+#include <algorithm>
+#include <queue>
+#include <thread>
+#include <limits>
+#include <cstdint>
+
+using namespace std;
+
+ShardedDatabase::ShardedDatabase(size_t shard_count) : next_id(1) {
+    if (shard_count == 0) {
+        shard_count = max(1u, thread::hardware_concurrency());
+    }
+    for (size_t i = 0; i < shard_count; i++) {
+        shards.push_back(unique_ptr<Shard>(new Shard()));
+        shards.back()->db.setVerbose(false);
+    }
+    for (size_t i = 1; i < shard_count; i++) {
+        shards[i]->worker = thread(serve, shards[i].get());
+    }
+}
+
+ShardedDatabase::~ShardedDatabase() {
+    for (size_t i = 1; i < shards.size(); i++) {
+        {
+            lock_guard<mutex> guard(shards[i]->queue_lock);
+            shards[i]->stopping = true;
+        }
+        shards[i]->queue_ready.notify_one();
+        shards[i]->worker.join();
+    }
+}
+
+void ShardedDatabase::serve(Shard* shard) {
+    for (;;) {
+        function<void()> job;
+        {
+            unique_lock<mutex> guard(shard->queue_lock);
+            shard->queue_ready.wait(guard, [shard]() {
+                return shard->stopping || !shard->queue.empty();
+            });
+            if (shard->queue.empty()) {
+                return;
+            }
+            job = move(shard->queue.front());
+            shard->queue.pop_front();
+        }
+        job();
+    }
+}
+
+size_t ShardedDatabase::shardFor(int id) const {
+    //  ,   ID    
+    uint32_t hash = static_cast<uint32_t>(id) * 2654435761u;
+    return (hash >> 16) % shards.size();
+}
+
+void ShardedDatabase::forEachShard(const function<void(size_t, Database&)>& work) const {
+    auto run = [this, &work](size_t index) {
+        lock_guard<mutex> guard(shards[index]->lock);
+        work(index, shards[index]->db);
+    };
+
+    //      ;   
+    //  ,     
+    mutex done_lock;
+    condition_variable done;
+    size_t remaining = shards.size() - 1;
+    for (size_t i = 1; i < shards.size(); i++) {
+        Shard& shard = *shards[i];
+        {
+            lock_guard<mutex> guard(shard.queue_lock);
+            shard.queue.push_back([&run, &done_lock, &done, &remaining, i]() {
+                run(i);
+                lock_guard<mutex> guard(done_lock);
+                if (--remaining == 0) {
+                    done.notify_one();
+                }
+            });
+        }
+        shard.queue_ready.notify_one();
+    }
+    run(0);  //      
+
+    unique_lock<mutex> guard(done_lock);
+    done.wait(guard, [&remaining]() { return remaining == 0; });
+}
+
+vector<Record> ShardedDatabase::gather(const function<vector<Record>(Database&)>& query,
+                                       SortField field, bool ascending, size_t limit) const {
+    vector<vector<Record> > parts(shards.size());
+    forEachShard([&parts, &query](size_t index, Database& db) {
+        parts[index] = query(db);
+    });
+
+    // k-     
+    typedef pair<size_t, size_t> Cursor;  // (, )
+    auto later = [&parts, field, ascending](const Cursor& a, const Cursor& b) {
+        return compareRecords(parts[b.first][b.second], parts[a.first][a.second], field, ascending);
+    };
+    priority_queue<Cursor, vector<Cursor>, decltype(later)> heads(later);
+
+    size_t total = 0;
+    for (size_t i = 0; i < parts.size(); i++) {
+        total += parts[i].size();
+        if (!parts[i].empty()) {
+            heads.push(Cursor(i, 0));
+        }
+    }
+
+    vector<Record> result;
+    result.reserve(min(total, limit));
+    while (!heads.empty() && result.size() < limit) {
+        Cursor cursor = heads.top();
+        heads.pop();
+        result.push_back(parts[cursor.first][cursor.second]);
+        if (cursor.second + 1 < parts[cursor.first].size()) {
+            heads.push(Cursor(cursor.first, cursor.second + 1));
+        }
+    }
+    return result;
+}
+
+int ShardedDatabase::addRecord(const string& name, int age, double salary) {
+    // FixedName   ,     ;
+    //    insertRecord
+    if (name.length() >= FixedName::CAPACITY) {
+        return 0;
+    }
+    Record record = Record();
+    record.id = next_id++;
+    record.name = name;
+    record.age = age;
+    record.salary = salary;
+
+    Shard& shard = *shards[shardFor(record.id)];
+    lock_guard<mutex> guard(shard.lock);
+    return shard.db.insertRecord(record) ? record.id : 0;
+}
+
+bool ShardedDatabase::editRecord(int id, const string& new_name, int new_age, double new_salary) {
+    Shard& shard = *shards[shardFor(id)];
+    lock_guard<mutex> guard(shard.lock);
+    return shard.db.editRecord(id, new_name, new_age, new_salary);
+}
+
+bool ShardedDatabase::deleteRecord(int id) {
+    Shard& shard = *shards[shardFor(id)];
+    lock_guard<mutex> guard(shard.lock);
+    return shard.db.deleteRecord(id);
+}
+
+vector<Record> ShardedDatabase::searchByName(const string& name) const {
+    return gather([&name](Database& db) { return db.searchByName(name); },
+                  SORT_BY_ID, true, numeric_limits<size_t>::max());
+}
+
+vector<Record> ShardedDatabase::searchByNamePrefix(const string& prefix) const {
+    return gather([&prefix](Database& db) { return db.searchByNamePrefix(prefix); },
+                  SORT_BY_ID, true, numeric_limits<size_t>::max());
+}
+
+vector<Record> ShardedDatabase::searchByAge(int age) const {
+    return gather([age](Database& db) { return db.searchByAge(age); },
+                  SORT_BY_ID, true, numeric_limits<size_t>::max());
+}
+
+vector<Record> ShardedDatabase::searchBySalary(double salary) const {
+    return gather([salary](Database& db) { return db.searchBySalary(salary); },
+                  SORT_BY_ID, true, numeric_limits<size_t>::max());
+}
+
+vector<Record> ShardedDatabase::searchByAgeAndSalary(int min_age, int max_age,
+                                                     double min_salary, double max_salary) const {
+    return gather([=](Database& db) {
+                      return db.searchByAgeAndSalary(min_age, max_age, min_salary, max_salary);
+                  },
+                  SORT_BY_ID, true, numeric_limits<size_t>::max());
+}
+
+vector<Record> ShardedDatabase::sorted(SortField field, bool ascending) const {
+    //  :     ,    
+    // -    
+    return gather([field, ascending](Database& db) {
+                      vector<Record> rows = db.getRecords();
+                      sort(rows.begin(), rows.end(), [field, ascending](const Record& a, const Record& b) {
+                          return compareRecords(a, b, field, ascending);
+                      });
+                      return rows;
+                  },
+                  field, ascending, numeric_limits<size_t>::max());
+}
+
+vector<Record> ShardedDatabase::topK(SortField field, size_t k, bool ascending) const {
+    return gather([field, k, ascending](Database& db) { return db.topK(field, k, ascending); },
+                  field, ascending, k);
+}
+
+Summary ShardedDatabase::summarize() const {
+    vector<Summary> parts(shards.size());
+    forEachShard([&parts](size_t index, Database& db) {
+        parts[index] = db.summarize();
+    });
+
+    Summary total;
+    for (const auto& part : parts) {
+        total.merge(part);
+    }
+    return total;
+}
+
+bool ShardedDatabase::loadFromFile(const string& filename) {
+    //    ,      
+    Database source;
+    if (!source.loadFromFile(filename)) {
+        return false;
+    }
+
+    vector<vector<const Record*> > buckets(shards.size());
+    int max_id = 0;
+    for (const auto& record : source.getRecords()) {
+        buckets[shardFor(record.id)].push_back(&record);
+        max_id = max(max_id, record.id);
+    }
+
+    for (auto& shard : shards) {
+        lock_guard<mutex> guard(shard->lock);
+        shard->db = Database();
+        shard->db.setVerbose(false);
+    }
+    forEachShard([&buckets](size_t index, Database& db) {
+        for (const Record* record : buckets[index]) {
+            db.insertRecord(*record);
+        }
+    });
+
+    next_id = max_id + 1;
+    return true;
+}
+
+size_t ShardedDatabase::size() const {
+    size_t total = 0;
+    for (const auto& shard : shards) {
+        lock_guard<mutex> guard(shard->lock);
+        total += shard->db.getRecords().size();
+    }
+    return total;
+}
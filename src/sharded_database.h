@@ -0,0 +1,72 @@
+#ifndef SHARDED_DATABASE_H
+#define SHARDED_DATABASE_H
+
+#include "database.h"
+#include <vector>
+#include <string>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <deque>
+#include <atomic>
+#include <functional>
+
+// ,   N   Database   ID.
+//     , ,   ,  
+//       ,    
+//      k-  .
+//       (   , 
+// ,    ),      .
+class ShardedDatabase {
+private:
+    struct Shard {
+        Database db;
+        mutable std::mutex lock;
+
+        //     
+        std::mutex queue_lock;
+        std::condition_variable queue_ready;
+        std::deque<std::function<void()> > queue;
+        bool stopping;
+        std::thread worker;
+
+        Shard() : stopping(false) {}
+    };
+
+    std::vector<std::unique_ptr<Shard> > shards;
+    std::atomic<int> next_id;
+
+    static void serve(Shard* shard);
+    size_t shardFor(int id) const;
+    void forEachShard(const std::function<void(size_t, Database&)>& work) const;
+    std::vector<Record> gather(const std::function<std::vector<Record>(Database&)>& query,
+                               SortField field, bool ascending, size_t limit) const;
+
+public:
+    // 0 -    
+    explicit ShardedDatabase(size_t shard_count = 0);
+    ~ShardedDatabase();
+
+    int addRecord(const std::string& name, int age, double salary);  // ID  0  
+    bool editRecord(int id, const std::string& new_name, int new_age, double new_salary);
+    bool deleteRecord(int id);
+
+    std::vector<Record> searchByName(const std::string& name) const;
+    std::vector<Record> searchByNamePrefix(const std::string& prefix) const;
+    std::vector<Record> searchByAge(int age) const;
+    std::vector<Record> searchBySalary(double salary) const;
+    std::vector<Record> searchByAgeAndSalary(int min_age, int max_age,
+                                             double min_salary, double max_salary) const;
+
+    std::vector<Record> sorted(SortField field, bool ascending = true) const;
+    std::vector<Record> topK(SortField field, size_t k, bool ascending = false) const;
+    Summary summarize() const;
+
+    bool loadFromFile(const std::string& filename);
+
+    size_t size() const;
+    size_t shardCount() const { return shards.size(); }
+};
+
+#endif